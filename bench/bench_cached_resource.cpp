@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmapCache>
+
+#include "resource.hpp"
+
+namespace {
+
+// something not trivial to draw, like a glyph
+class ShapeResource final : public Resource
+{
+public:
+  QRectF rect() const noexcept override { return {0, -40, 30, 50}; }
+  qreal advanceX() const noexcept override { return 32; }
+  qreal advanceY() const noexcept override { return 50; }
+
+  void draw(QPainter* p) override
+  {
+    QPainterPath path;
+    path.addRoundedRect(rect().adjusted(2, 2, -2, -2), 6, 6);
+    path.addEllipse(rect().center(), 8, 12);
+    p->drawPath(path);
+  }
+
+  size_t cacheKey() const noexcept override { return 42; }
+};
+
+} // namespace
+
+class BenchCachedResource : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+
+  void draw_data();
+  void draw();
+
+private:
+  QImage _canvas;
+};
+
+void BenchCachedResource::init()
+{
+  _canvas = QImage(256, 256, QImage::Format_ARGB32_Premultiplied);
+  _canvas.fill(Qt::transparent);
+  QPixmapCache::clear();
+}
+
+void BenchCachedResource::draw_data()
+{
+  QTest::addColumn<bool>("cached");
+  QTest::addColumn<bool>("cache_hit");
+
+  QTest::newRow("uncached") << false << false;
+  QTest::newRow("cache hit") << true << true;
+  QTest::newRow("cache miss") << true << false;
+}
+
+void BenchCachedResource::draw()
+{
+  QFETCH(bool, cached);
+  QFETCH(bool, cache_hit);
+
+  std::shared_ptr<Resource> res = std::make_shared<ShapeResource>();
+  if (cached)
+    res = std::make_shared<CachedResource>(std::move(res));
+
+  QPainter p(&_canvas);
+  p.setRenderHint(QPainter::Antialiasing);
+  p.setBrush(Qt::red);
+  p.translate(100, 100);
+  p.scale(2.0, 2.0);
+
+  res->draw(&p);    // warm up the cache
+
+  QBENCHMARK {
+    if (!cache_hit)
+      QPixmapCache::clear();
+    res->draw(&p);
+  }
+}
+
+QTEST_MAIN(BenchCachedResource)
+
+#include "bench_cached_resource.moc"
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include "classic_skin.hpp"
+#include "legacy_skin_loader.hpp"
+#include "shared_assets.hpp"
+
+class BenchClassicSkin : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void process_data();
+  void process();
+
+private:
+  std::shared_ptr<ClassicSkin> _font_skin;
+  std::shared_ptr<ClassicSkin> _image_skin;
+};
+
+void BenchClassicSkin::initTestCase()
+{
+  _font_skin = std::make_shared<ClassicSkin>(SharedFontResourceFactory(QFont()));
+  _font_skin->setSupportsGlyphBaseHeight(false);
+
+  LegacySkinLoader loader(ELECTRONIC_SKIN_DIR);
+  _image_skin = loader.skin();
+  QVERIFY(_image_skin);
+}
+
+void BenchClassicSkin::cleanupTestCase()
+{
+  _image_skin.reset();
+  _font_skin.reset();
+}
+
+void BenchClassicSkin::process_data()
+{
+  QTest::addColumn<bool>("image");
+  QTest::addColumn<QString>("format");
+  // 0 - the same time every frame (memoized path), 1 - typical clock update
+  QTest::addColumn<int>("step");
+
+  for (bool image : {false, true}) {
+    const char* type = image ? "image" : "font";
+    for (const char* format : {"hh:mm", "hh:mm:ss"}) {
+      QTest::addRow("%s %s same", type, format) << image << QString(format) << 0;
+      QTest::addRow("%s %s tick", type, format) << image << QString(format) << 1;
+    }
+  }
+}
+
+void BenchClassicSkin::process()
+{
+  QFETCH(bool, image);
+  QFETCH(QString, format);
+  QFETCH(int, step);
+
+  auto skin = image ? _image_skin : _font_skin;
+  skin->setFormat(format);
+
+  QDateTime dt(QDate(2024, 9, 18), QTime(21, 7, 42));
+  std::shared_ptr<Resource> res;
+
+  QBENCHMARK {
+    dt = dt.addSecs(step);
+    res = skin->process(dt);
+  }
+
+  QVERIFY(res);
+  QVERIFY(!res->rect().isEmpty());
+}
+
+QTEST_MAIN(BenchClassicSkin)
+
+#include "bench_classic_skin.moc"
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include "datetime_formatter.hpp"
+
+namespace {
+
+// just counts characters, so builder cost is negligible
+class CountingBuilder final : public DateTimeStringBuilder
+{
+public:
+  void addCharacters(std::span<const char32_t> chars) override { _count += chars.size(); }
+  void addToken(int, QStringView, std::span<const char32_t> chars) override { _count += chars.size(); }
+
+  std::size_t count() const noexcept { return _count; }
+
+private:
+  std::size_t _count = 0;
+};
+
+void addStandardFormats()
+{
+  QTest::addColumn<QString>("format");
+
+  QTest::newRow("hh:mm") << QString("hh:mm");
+  QTest::newRow("hh:mm:ss") << QString("hh:mm:ss");
+  QTest::newRow("h:mm a") << QString("h:mm a");
+  QTest::newRow("h:mm:ss AP") << QString("h:mm:ss AP");
+  QTest::newRow("date and time") << QString("dd.MM.yyyy hh:mm:ss");
+  QTest::newRow("names") << QString("dddd, d MMMM yyyy\\nHH:mm");
+}
+
+} // namespace
+
+class BenchDateTimeFormatter : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+
+  void formatCompiled_data();
+  void formatCompiled();
+
+  void formatString_data();
+  void formatString();
+
+  void compileFormat_data();
+  void compileFormat();
+
+private:
+  QDateTime _dt;
+  DateTimeLocale _locale;
+};
+
+void BenchDateTimeFormatter::initTestCase()
+{
+  // fixed value for repeatable results
+  _dt = QDateTime(QDate(2024, 9, 18), QTime(21, 7, 42));
+}
+
+void BenchDateTimeFormatter::formatCompiled_data()
+{
+  addStandardFormats();
+}
+
+void BenchDateTimeFormatter::formatCompiled()
+{
+  QFETCH(QString, format);
+
+  const DateTimeFormat fmt(format);
+  CountingBuilder builder;
+
+  QBENCHMARK {
+    FormatDateTime(_dt, fmt, _locale, builder);
+  }
+
+  QVERIFY(builder.count() > 0);
+}
+
+void BenchDateTimeFormatter::formatString_data()
+{
+  addStandardFormats();
+}
+
+// format is compiled on each call, baseline for the compiled version
+void BenchDateTimeFormatter::formatString()
+{
+  QFETCH(QString, format);
+
+  CountingBuilder builder;
+
+  QBENCHMARK {
+    FormatDateTime(_dt, format, builder);
+  }
+
+  QVERIFY(builder.count() > 0);
+}
+
+void BenchDateTimeFormatter::compileFormat_data()
+{
+  addStandardFormats();
+}
+
+void BenchDateTimeFormatter::compileFormat()
+{
+  QFETCH(QString, format);
+
+  QBENCHMARK {
+    DateTimeFormat fmt(format);
+    Q_UNUSED(fmt);
+  }
+}
+
+QTEST_GUILESS_MAIN(BenchDateTimeFormatter)
+
+#include "bench_datetime_formatter.moc"
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+
+#include "render_utils.hpp"
+
+// end-to-end frame benchmark: skin processing + painting,
+// the same way as clock widget does it, but into an image
+namespace {
+
+constexpr int frames_count = 600;   // 10 minutes of clock updates
+
+} // namespace
+
+class BenchFrame : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void renderFrames_data();
+  void renderFrames();
+};
+
+void BenchFrame::renderFrames_data()
+{
+  QTest::addColumn<QString>("skin");
+  QTest::addColumn<qreal>("scale");
+  QTest::addColumn<qreal>("dpr");
+
+  for (const char* skin : {"dseg", "electronic"})
+    for (qreal scale : {1.0, 2.0})
+      for (qreal dpr : {1.0, 2.0})
+        QTest::addRow("%s x%.1f dpr %.1f", skin, scale, dpr) << QString(skin) << scale << dpr;
+}
+
+void BenchFrame::renderFrames()
+{
+  QFETCH(QString, skin);
+  QFETCH(qreal, scale);
+  QFETCH(qreal, dpr);
+
+  auto s = LoadSkin(QDir(SKINS_DIR).filePath(skin), "hh:mm:ss");
+  QVERIFY(s);
+
+  FrameTimes process_times;
+  FrameTimes draw_times;
+  FrameTimes total_times;
+
+  QImage canvas;
+  QDateTime dt(QDate(2024, 9, 18), QTime(23, 55, 0));   // includes day change
+  QElapsedTimer timer;
+
+  for (int i = 0; i < frames_count; i++) {
+    timer.start();
+    s->animateSeparator();
+    auto glyph = s->process(dt);
+    const auto process_time = timer.nsecsElapsed();
+    QVERIFY(glyph);
+
+    // canvas is reused while its size is the same, as widget's backing store does
+    const auto sz = FrameSize(*glyph, scale, dpr);
+    if (canvas.size() != sz) {
+      canvas = QImage(sz, QImage::Format_ARGB32_Premultiplied);
+      canvas.setDevicePixelRatio(dpr);
+    }
+    DrawFrame(canvas, *glyph, scale);
+    const auto total_time = timer.nsecsElapsed();
+
+    process_times.add(process_time);
+    draw_times.add(total_time - process_time);
+    total_times.add(total_time);
+
+    dt = dt.addSecs(1);
+  }
+
+  qInfo().noquote() << process_times.report("process");
+  qInfo().noquote() << draw_times.report("draw");
+  qInfo().noquote() << total_times.report("total");
+
+  QTest::setBenchmarkResult(total_times.percentile(0.5), QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(BenchFrame)
+
+#include "bench_frame.moc"
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QBrush>
+#include <QLinearGradient>
+#include <QPixmap>
+
+#include "hasher.hpp"
+
+class BenchHasher : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void skinConfig_data();
+  void skinConfig();
+
+  void simpleValues();
+};
+
+void BenchHasher::skinConfig_data()
+{
+  QTest::addColumn<QBrush>("texture");
+  QTest::addColumn<QBrush>("background");
+
+  QLinearGradient gradient(0, 0, 1, 1);
+  gradient.setColorAt(0.0, Qt::red);
+  gradient.setColorAt(0.5, Qt::green);
+  gradient.setColorAt(1.0, Qt::blue);
+  gradient.setCoordinateMode(QGradient::ObjectMode);
+
+  QPixmap pattern(64, 64);
+  pattern.fill(Qt::magenta);
+
+  QTest::newRow("colors") << QBrush(Qt::red) << QBrush(Qt::NoBrush);
+  QTest::newRow("gradients") << QBrush(gradient) << QBrush(gradient);
+  QTest::newRow("pattern") << QBrush(pattern) << QBrush(QColor(0, 0, 0, 160));
+}
+
+// the same set of values as ClassicSkinBase uses
+void BenchHasher::skinConfig()
+{
+  QFETCH(QBrush, texture);
+  QFETCH(QBrush, background);
+
+  size_t h = 0;
+
+  QBENCHMARK {
+    h = hasher(texture, false, true, background, false, false);
+  }
+
+  QCOMPARE(h, hasher(texture, false, true, background, false, false));
+}
+
+void BenchHasher::simpleValues()
+{
+  size_t h = 0;
+
+  QBENCHMARK {
+    h = hasher(42, 3.14, true, QString("hh:mm:ss"));
+  }
+
+  QVERIFY(h != hasher(43, 3.14, true, QString("hh:mm:ss")));
+}
+
+QTEST_MAIN(BenchHasher)
+
+#include "bench_hasher.moc"
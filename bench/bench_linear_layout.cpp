@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include "linear_layout.hpp"
+
+namespace {
+
+std::shared_ptr<LinearLayout> createLayout(int items_count, Qt::Orientation o)
+{
+  auto layout = std::make_shared<LinearLayout>(o, 2.0);
+  layout->reserve(items_count);
+  for (int i = 0; i < items_count; i++) {
+    // slightly different geometry to make alignment do some work
+    auto res = std::make_shared<InvisibleResource>(QRectF(0, -10 - i % 3, 8, 12 + i % 5), 9, 14);
+    layout->addItem(std::make_shared<LayoutItem>(std::move(res)));
+  }
+  return layout;
+}
+
+} // namespace
+
+class BenchLinearLayout : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void buildLayout_data();
+  void buildLayout();
+
+  void addItems_data();
+  void addItems();
+};
+
+void BenchLinearLayout::buildLayout_data()
+{
+  QTest::addColumn<int>("items_count");
+  QTest::addColumn<Qt::Orientation>("orientation");
+
+  for (int n : {4, 8, 16, 64, 256}) {
+    QTest::addRow("horizontal_%d", n) << n << Qt::Horizontal;
+    QTest::addRow("vertical_%d", n) << n << Qt::Vertical;
+  }
+}
+
+void BenchLinearLayout::buildLayout()
+{
+  QFETCH(int, items_count);
+  QFETCH(Qt::Orientation, orientation);
+
+  auto layout = createLayout(items_count, orientation);
+
+  QBENCHMARK {
+    layout->updateGeometry();
+  }
+
+  QVERIFY(!layout->rect().isEmpty());
+}
+
+void BenchLinearLayout::addItems_data()
+{
+  QTest::addColumn<int>("items_count");
+
+  for (int n : {8, 64, 256})
+    QTest::addRow("%d", n) << n;
+}
+
+void BenchLinearLayout::addItems()
+{
+  QFETCH(int, items_count);
+
+  std::shared_ptr<LinearLayout> layout;
+
+  QBENCHMARK {
+    layout = createLayout(items_count, Qt::Horizontal);
+    layout->updateGeometry();
+  }
+
+  QCOMPARE(layout->items().size(), static_cast<std::size_t>(items_count));
+}
+
+QTEST_GUILESS_MAIN(BenchLinearLayout)
+
+#include "bench_linear_layout.moc"
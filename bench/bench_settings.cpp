@@ -0,0 +1,340 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QElapsedTimer>
+#include <QLinearGradient>
+#include <QTemporaryDir>
+
+#include "app_config.hpp"
+#include "backend_qsettings.hpp"
+#include "settings_export.hpp"
+
+namespace {
+
+using ConfigStorageType = ConfigStorage<QString, QString, QVariant>;
+using ConfigBackendType = ConfigBackend<QString, QString, QVariant>;
+
+constexpr int windows_count = 8;
+
+// the fastest possible backend, shows the cost of the storage itself
+class MemoryBackend final : public ConfigBackendType
+{
+public:
+  void load(const QString&) override {}
+  void save(const QString&) override {}
+
+  SettingsData allSettings() const override { return _settings; }
+
+  SettingsMap tagSettings(const QString& tag) const override
+  {
+    auto iter = _settings.find(tag);
+    return iter != _settings.end() ? iter->second : SettingsMap();
+  }
+
+  void setValue(const QString& tag, const QString& k, const QVariant& v) override
+  {
+    _settings[tag][k] = v;
+  }
+
+  std::optional<QVariant> value(const QString& tag, const QString& k) const override
+  {
+    auto titer = _settings.find(tag);
+    if (titer == _settings.end())
+      return std::nullopt;
+
+    auto viter = titer->second.find(k);
+    if (viter == titer->second.end())
+      return std::nullopt;
+
+    return viter->second;
+  }
+
+private:
+  SettingsData _settings;
+};
+
+// values as after some customization, for all windows
+void populate(AppConfig& cfg)
+{
+  QLinearGradient gradient(0, 0, 1, 0);
+  gradient.setColorAt(0.0, Qt::cyan);
+  gradient.setColorAt(1.0, Qt::magenta);
+  gradient.setCoordinateMode(QGradient::ObjectMode);
+
+  cfg.global().setWindowsCount(windows_count);
+  cfg.global().setConfigPerWindow(true);
+  for (int i = 0; i < windows_count; i++) {
+    auto& wcfg = cfg.window(i);
+    wcfg.appearance().setOpacity(0.75);
+    wcfg.appearance().setScaleFactorX(150);
+    wcfg.appearance().setScaleFactorY(150);
+    wcfg.appearance().setColorizationColor(QColor(i * 30, 128, 64));
+    wcfg.classicSkin().setTimeFormat("hh:mm:ss");
+    wcfg.classicSkin().setTexture(QBrush(gradient));
+    wcfg.classicSkin().setBackground(QColor(0, 0, 0, 160));
+    wcfg.classicSkin().setSpacing(4);
+    wcfg.classicSkin().setSecondsScaleFactor(60);
+    wcfg.state().setLastUsedSkin(QString("Skin %1").arg(i));
+    wcfg.state().setTextureGradient(gradient);
+  }
+  cfg.commit();
+}
+
+void addBackends()
+{
+  QTest::addColumn<QString>("backend");
+
+  QTest::newRow("ini") << QString("ini");
+  QTest::newRow("memory") << QString("memory");
+}
+
+} // namespace
+
+class BenchSettings : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+  void cleanup();
+
+  void typedGetters_data();
+  void typedGetters();
+
+  void rawGetters_data();
+  void rawGetters();
+
+  void setters_data();
+  void setters();
+
+  void commitDirtyKeys_data();
+  void commitDirtyKeys();
+
+  void exportSettings_data();
+  void exportSettings();
+
+  void importSettings_data();
+  void importSettings();
+
+  void serializeSettings();
+  void deserializeSettings();
+
+private:
+  void createStorage(const QString& backend);
+
+private:
+  std::unique_ptr<QTemporaryDir> _dir;
+  std::shared_ptr<ConfigStorageType> _storage;
+  std::unique_ptr<AppConfig> _config;
+};
+
+void BenchSettings::init()
+{
+  _dir = std::make_unique<QTemporaryDir>();
+  QVERIFY(_dir->isValid());
+}
+
+void BenchSettings::cleanup()
+{
+  _config.reset();
+  _storage.reset();
+  _dir.reset();
+}
+
+void BenchSettings::createStorage(const QString& backend)
+{
+  std::shared_ptr<ConfigBackendType> b;
+  if (backend == "ini")
+    b = std::make_shared<BackendQSettings>(_dir->filePath("settings.ini"));
+  else
+    b = std::make_shared<MemoryBackend>();
+
+  _storage = std::make_shared<ConfigStorageType>(std::move(b));
+  _config = std::make_unique<AppConfig>(_storage);
+  populate(*_config);
+}
+
+void BenchSettings::typedGetters_data()
+{
+  addBackends();
+}
+
+// the way how the app reads settings
+void BenchSettings::typedGetters()
+{
+  QFETCH(QString, backend);
+  createStorage(backend);
+
+  int spacing = 0;
+  QBrush texture;
+
+  QBENCHMARK {
+    for (int i = 0; i < windows_count; i++) {
+      const auto& scfg = _config->window(i).classicSkin();
+      spacing += scfg.getSpacing();
+      texture = scfg.getTexture();
+    }
+  }
+
+  QVERIFY(spacing > 0);
+  QVERIFY(texture.gradient());
+}
+
+void BenchSettings::rawGetters_data()
+{
+  addBackends();
+}
+
+// values are converted on each call
+void BenchSettings::rawGetters()
+{
+  QFETCH(QString, backend);
+  createStorage(backend);
+
+  auto client = _storage->client("Window0/ClassicSkin");
+  int spacing = 0;
+  QBrush texture;
+
+  QBENCHMARK {
+    for (int i = 0; i < windows_count; i++) {
+      spacing += client->value("Spacing", 8);
+      texture = client->value("Texture", QBrush());
+    }
+  }
+
+  QVERIFY(spacing > 0);
+  QVERIFY(texture.gradient());
+}
+
+void BenchSettings::setters_data()
+{
+  addBackends();
+}
+
+void BenchSettings::setters()
+{
+  QFETCH(QString, backend);
+  createStorage(backend);
+
+  auto& scfg = _config->window(0).classicSkin();
+  int i = 0;
+
+  QBENCHMARK {
+    scfg.setSpacing(i++ % 32);
+  }
+
+  _config->commit();
+  QCOMPARE(scfg.getSpacing(), (i - 1) % 32);
+}
+
+void BenchSettings::commitDirtyKeys_data()
+{
+  QTest::addColumn<QString>("backend");
+  QTest::addColumn<int>("dirty_keys");
+
+  for (const char* backend : {"ini", "memory"})
+    for (int n : {1, 16, 128, 1024})
+      QTest::addRow("%s %d", backend, n) << QString(backend) << n;
+}
+
+// only commit() call is measured, keys are changed before it
+void BenchSettings::commitDirtyKeys()
+{
+  QFETCH(QString, backend);
+  QFETCH(int, dirty_keys);
+  createStorage(backend);
+
+  constexpr int iterations = 50;
+
+  auto client = _storage->client("Bench");
+  QElapsedTimer timer;
+  qint64 total = 0;
+
+  for (int i = 0; i < iterations; i++) {
+    for (int k = 0; k < dirty_keys; k++)
+      client->setValue(QString("key%1").arg(k), i);
+    timer.start();
+    client->commit();
+    total += timer.nsecsElapsed();
+  }
+
+  QCOMPARE(client->value(QString("key%1").arg(dirty_keys - 1), -1), iterations - 1);
+  QTest::setBenchmarkResult(total / iterations, QTest::WalltimeNanoseconds);
+}
+
+void BenchSettings::exportSettings_data()
+{
+  addBackends();
+}
+
+void BenchSettings::exportSettings()
+{
+  QFETCH(QString, backend);
+  createStorage(backend);
+
+  ConfigStorageType::SettingsData data;
+
+  QBENCHMARK {
+    data = _storage->exportSettings();
+  }
+
+  QVERIFY(data.size() >= windows_count * 4);
+}
+
+void BenchSettings::importSettings_data()
+{
+  addBackends();
+}
+
+void BenchSettings::importSettings()
+{
+  QFETCH(QString, backend);
+  createStorage(backend);
+
+  const auto data = _storage->exportSettings();
+
+  QBENCHMARK {
+    _storage->importSettings(data);
+    _storage->discardImported();
+  }
+}
+
+// export file compression cost, doesn't depend on backend
+void BenchSettings::serializeSettings()
+{
+  createStorage("memory");
+  const auto data = _storage->exportSettings();
+
+  QByteArray bytes;
+
+  QBENCHMARK {
+    bytes = SerializeSettings(data);
+  }
+
+  QVERIFY(!bytes.isEmpty());
+}
+
+void BenchSettings::deserializeSettings()
+{
+  createStorage("memory");
+  const auto data = _storage->exportSettings();
+  const auto bytes = SerializeSettings(data);
+
+  std::optional<ExportedSettings> result;
+
+  QBENCHMARK {
+    result = DeserializeSettings(bytes);
+  }
+
+  QVERIFY(result);
+  QCOMPARE(result->size(), data.size());
+}
+
+QTEST_MAIN(BenchSettings)
+
+#include "bench_settings.moc"
@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include "skin_finder.hpp"
+
+namespace {
+
+constexpr int legacy_skins_count = 200;
+constexpr int modern_skins_count = 100;
+
+bool writeFile(const QString& filename, const QByteArray& data)
+{
+  QFile f(filename);
+  return f.open(QIODevice::WriteOnly) && f.write(data) == data.size();
+}
+
+bool createLegacySkin(const QDir& root, int i)
+{
+  const auto dir_name = QString("legacy_%1").arg(i);
+  if (!root.mkdir(dir_name))
+    return false;
+
+  QDir skin_dir(root.filePath(dir_name));
+  const auto skin_ini = QString("[info]\nname=Legacy Skin %1\n").arg(i).toUtf8();
+  if (!writeFile(skin_dir.filePath("skin.ini"), skin_ini))
+    return false;
+
+  const QByteArray svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="10" height="20"/>)";
+  for (const auto& name : {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "s1", "s2"})
+    if (!writeFile(skin_dir.filePath(QString("%1.svg").arg(name)), svg))
+      return false;
+
+  return true;
+}
+
+bool createModernSkin(const QDir& root, int i)
+{
+  const auto dir_name = QString("modern_%1").arg(i);
+  if (!root.mkdir(dir_name))
+    return false;
+
+  QDir skin_dir(root.filePath(dir_name));
+  const auto skin_json = QString(R"({"name": "Modern Skin %1", "layout": []})").arg(i).toUtf8();
+  return writeFile(skin_dir.filePath("skin.json"), skin_json);
+}
+
+} // namespace
+
+class BenchSkinFinder : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void findSkins_data();
+  void findSkins();
+
+  void lastPathWins();
+
+private:
+  QTemporaryDir _skins_dir;
+  int _max_threads = 0;
+};
+
+void BenchSkinFinder::initTestCase()
+{
+  QVERIFY(_skins_dir.isValid());
+  QDir root(_skins_dir.path());
+  for (int i = 0; i < legacy_skins_count; i++)
+    QVERIFY(createLegacySkin(root, i));
+  for (int i = 0; i < modern_skins_count; i++)
+    QVERIFY(createModernSkin(root, i));
+  // some garbage which must be ignored
+  QVERIFY(root.mkdir("empty_dir"));
+  QVERIFY(writeFile(root.filePath("not_a_skin.txt"), "garbage"));
+
+  _max_threads = QThreadPool::globalInstance()->maxThreadCount();
+}
+
+void BenchSkinFinder::cleanupTestCase()
+{
+  QThreadPool::globalInstance()->setMaxThreadCount(_max_threads);
+}
+
+void BenchSkinFinder::findSkins_data()
+{
+  QTest::addColumn<int>("threads");
+
+  QTest::newRow("sequential") << 1;
+  QTest::newRow("parallel") << _max_threads;
+}
+
+void BenchSkinFinder::findSkins()
+{
+  QFETCH(int, threads);
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  const QStringList search_paths = {_skins_dir.path()};
+  SkinLocations skins;
+
+  QBENCHMARK {
+    skins = FindSkins(search_paths);
+  }
+
+  QCOMPARE(skins.size(), legacy_skins_count + modern_skins_count);
+  QVERIFY(skins.value("Legacy Skin 0").type == SkinType::Legacy);
+  QVERIFY(skins.value("Modern Skin 0").type == SkinType::Modern);
+}
+
+void BenchSkinFinder::lastPathWins()
+{
+  QTemporaryDir override_dir;
+  QVERIFY(override_dir.isValid());
+  QVERIFY(createModernSkin(QDir(override_dir.path()), 0));
+
+  const auto skins = FindSkins({_skins_dir.path(), override_dir.path()});
+  QCOMPARE(skins.size(), legacy_skins_count + modern_skins_count);
+  QVERIFY(skins.value("Modern Skin 0").path.startsWith(override_dir.path()));
+}
+
+QTEST_GUILESS_MAIN(BenchSkinFinder)
+
+#include "bench_skin_finder.moc"
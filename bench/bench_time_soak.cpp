@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+
+#include "app/clock_widget.hpp"
+#include "app/time_source.hpp"
+#include "render_utils.hpp"
+
+// soak benchmark: the whole day of clock ticks is replayed through
+// the same path as the app does (time source -> widget -> paint),
+// but as fast as possible, time spent per local hour is reported
+// to find time-dependent performance cliffs
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr auto tick_interval = 500ms;   // the same as the real time source
+
+// tick times in nanoseconds, grouped by local hour
+struct HourStats {
+  qint64 total = 0;
+  qint64 max = 0;
+  int ticks = 0;
+};
+
+} // namespace
+
+class BenchTimeSoak : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void replayDay_data();
+  void replayDay();
+};
+
+void BenchTimeSoak::replayDay_data()
+{
+  QTest::addColumn<QString>("skin");
+  QTest::addColumn<QByteArray>("tz");
+  QTest::addColumn<QDate>("date");
+
+  for (const char* skin : {"dseg", "electronic"}) {
+    QTest::addRow("%s dst start", skin) << QString(skin) << QByteArray("Europe/Berlin") << QDate(2024, 3, 31);
+    QTest::addRow("%s dst end", skin) << QString(skin) << QByteArray("Europe/Berlin") << QDate(2024, 10, 27);
+    QTest::addRow("%s leap day", skin) << QString(skin) << QByteArray("UTC") << QDate(2024, 2, 29);
+  }
+}
+
+void BenchTimeSoak::replayDay()
+{
+  QFETCH(QString, skin);
+  QFETCH(QByteArray, tz);
+  QFETCH(QDate, date);
+
+  const QTimeZone time_zone(tz);
+  if (!time_zone.isValid())
+    QSKIP("time zone is not available");
+
+  std::shared_ptr<Skin> s = LoadSkin(QDir(SKINS_DIR).filePath(skin), "hh:mm:ss");
+  QVERIFY(s);
+
+  ClockWidget widget;
+  widget.setSkin(s);
+  widget.setTimeZone(time_zone);
+  widget.show();
+  QVERIFY(QTest::qWaitForWindowExposed(&widget));
+
+  const QDateTime start(date, QTime(0, 0), time_zone);
+  const QDateTime end = start.addDays(1);   // day may be 23 or 25 hours long
+
+  // connected exactly as the app does, see ApplicationPrivate::createWindow()
+  SimulatedTimeSource time_src(start, tick_interval);
+  connect(&time_src, &TimeSource::timeChanged, &widget, &ClockWidget::setDateTime);
+  connect(&time_src, &TimeSource::timeChanged, &widget, &ClockWidget::animateSeparator);
+
+  std::array<HourStats, 24> hours{};
+  int ticks = 0;
+  QElapsedTimer total_timer;
+  QElapsedTimer timer;
+  total_timer.start();
+
+  time_src.setTime(start);
+  while (time_src.now() < end) {
+    timer.start();
+    time_src.advance();
+    // let widget repaint itself as it happens in the app's event loop
+    QCoreApplication::processEvents();
+    const auto t = timer.nsecsElapsed();
+
+    auto& h = hours[time_src.now().toTimeZone(time_zone).time().hour()];
+    h.total += t;
+    h.max = std::max(h.max, t);
+    h.ticks++;
+    ticks++;
+  }
+  const auto total = total_timer.nsecsElapsed();
+
+  for (std::size_t i = 0; i < hours.size(); i++) {
+    const auto& h = hours[i];
+    if (h.ticks == 0) continue;
+    qInfo("%02zu:00  ticks %5d  avg %7.1f us  max %8.1f us",
+          i, h.ticks, h.total / 1000. / h.ticks, h.max / 1000.);
+  }
+  qInfo("%d ticks in %.2f s (%.0f ticks/s), paints: %llu",
+        ticks, total / 1e9, ticks / (total / 1e9),
+        static_cast<unsigned long long>(widget.frameStats().frames()));
+
+  QVERIFY(ticks > 0);
+  QTest::setBenchmarkResult(total / ticks, QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(BenchTimeSoak)
+
+#include "bench_time_soak.moc"
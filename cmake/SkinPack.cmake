@@ -0,0 +1,39 @@
+# SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# packs skin directory into single skin pack file
+#
+# add_skin_pack(<target> <skin_dir> [OUTPUT <file>])
+#
+# skin pack is Qt binary resource with all skin files at its root,
+# files are not compressed, so they can be used right from mapped memory
+# resulting file is <skin_dir_name>.dcskin in current binary dir by default
+function(add_skin_pack target skin_dir)
+    cmake_parse_arguments(PARSE_ARGV 2 arg "" "OUTPUT" "")
+
+    get_filename_component(skin_dir "${skin_dir}" ABSOLUTE)
+    get_filename_component(skin_name "${skin_dir}" NAME)
+
+    if (NOT arg_OUTPUT)
+        set(arg_OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/${skin_name}.dcskin")
+    endif()
+
+    file(GLOB_RECURSE skin_files RELATIVE "${skin_dir}" CONFIGURE_DEPENDS "${skin_dir}/*")
+    list(SORT skin_files)
+
+    set(qrc_content "<RCC>\n    <qresource prefix=\"/\">\n")
+    foreach(skin_file IN LISTS skin_files)
+        string(APPEND qrc_content "        <file alias=\"${skin_file}\">${skin_dir}/${skin_file}</file>\n")
+    endforeach()
+    string(APPEND qrc_content "    </qresource>\n</RCC>\n")
+
+    # .qrc file must exist at configure time
+    set(qrc_file "${CMAKE_CURRENT_BINARY_DIR}/${target}.qrc")
+    file(WRITE "${qrc_file}" "${qrc_content}")
+
+    qt_add_binary_resources(${target} "${qrc_file}"
+        DESTINATION "${arg_OUTPUT}"
+        OPTIONS --no-compress
+    )
+endfunction()
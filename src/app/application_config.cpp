@@ -8,25 +8,60 @@
 #include "application_private.hpp"
 
 #include <QDir>
+#include <QStandardPaths>
 
+#include "backend_binary.hpp"
 #include "backend_qsettings.hpp"
 #include "settings_manager.hpp"
 
 void ApplicationPrivate::initConfig()
 {
   using namespace Qt::Literals::StringLiterals;
-  auto backend = std::make_shared<BackendQSettings>();
+  auto legacy_backend = std::make_shared<BackendQSettings>();
+  QDir config_dir(QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation));
 #ifndef Q_OS_MACOS
   QDir app_dir(QApplication::applicationDirPath());
-  if (app_dir.exists(u"portable.txt"_s) || app_dir.exists(u".portable"_s))
-    backend = std::make_shared<BackendQSettings>(app_dir.absoluteFilePath(u"settings.ini"_s));
+  if (app_dir.exists(u"portable.txt"_s) || app_dir.exists(u".portable"_s)) {
+    legacy_backend = std::make_shared<BackendQSettings>(app_dir.absoluteFilePath(u"settings.ini"_s));
+    config_dir = app_dir;
+  }
 #endif
-  _app_state = std::make_unique<AppState>(backend);
-  _config_storage = std::make_shared<ConfigStorageType>(std::move(backend));
+  config_dir.mkpath(u"."_s);
+  std::shared_ptr<ConfigBackend<QString, QString, QVariant>> backend;
+  const auto settings_file = config_dir.absoluteFilePath(u"settings.dcb"_s);
+  auto binary_backend = std::make_shared<BackendBinary>(settings_file);
+  // file exists, but can't be read, keep it aside for recovery,
+  // if even this is not possible it is left untouched
+  if (binary_backend->isBroken())
+    binary_backend->backupBroken(settings_file + u".bak"_s);
+  // one-time migration (only if there is no file), old settings are left untouched
+  if (!binary_backend->isLoaded())
+    binary_backend->migrateFrom(*legacy_backend);
+  // fallback to old storage if new one can't be used for some reason
+  if (binary_backend->isLoaded())
+    backend = std::move(binary_backend);
+  else
+    backend = std::move(legacy_backend);
+  // writes are coalesced and flushed after some quiet period
+  _settings_flush_timer.setSingleShot(true);
+  _settings_flush_timer.setInterval(1000);
+  connect(&_settings_flush_timer, &QTimer::timeout, this, &ApplicationPrivate::flushSettings);
+  connect(qApp, &QCoreApplication::aboutToQuit, this, &ApplicationPrivate::flushSettings);
+  _settings_backend = std::make_shared<SettingsBackendType>(
+        std::move(backend), [this]() { _settings_flush_timer.start(); });
+  _app_state = std::make_unique<AppState>(_settings_backend);
+  _config_storage = std::make_shared<ConfigStorageType>(_settings_backend);
   _app_config = std::make_unique<AppConfig>(_config_storage);
   _settings_manager = std::make_unique<SettingsManagerImpl>(this);
 }
 
+void ApplicationPrivate::flushSettings()
+{
+  _settings_flush_timer.stop();
+  if (_settings_backend)
+    _settings_backend->flush();
+}
+
 void Application::initConfig()
 {
   _impl->initConfig();
@@ -7,12 +7,20 @@
 #include "application.hpp"
 #include "application_private.hpp"
 
+#include <QApplication>
+
 #include "layout_debug.hpp"
 #include "skin_manager.hpp"
+#include "trace.hpp"
 
 void ApplicationPrivate::initCore()
 {
-  _time_src = std::make_unique<TimeSource>();
+  if (auto trace_file = qEnvironmentVariable(trace::TraceFileVar); !trace_file.isEmpty())
+    trace::start(trace_file);
+  // trace file is written only when tracing is stopped
+  connect(qApp, &QCoreApplication::aboutToQuit, this, []() { trace::stop(); });
+
+  _time_src = std::make_unique<SystemTimeSource>();
   _skin_manager = std::make_unique<SkinManagerImpl>(this);
   if (_app_config->global().getChangeOpacityOnMouseHover())
     _mouse_tracker = std::make_unique<MouseTracker>();
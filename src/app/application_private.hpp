@@ -13,6 +13,7 @@
 
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QTimer>
 #include <QtCore/QVariant>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QSystemTrayIcon>
@@ -24,6 +25,7 @@
 #include "app_config.hpp"
 #include "app_state.hpp"
 #include "core/settings.hpp"
+#include "core/write_behind_backend.hpp"
 #include "platform/mouse_tracker.hpp"
 #ifdef Q_OS_WINDOWS
 #include "platform/win/stay_on_top_hacks.hpp"
@@ -42,6 +44,8 @@ public:
   virtual SkinPtr loadSkin(const QString& skin_name) const = 0;
   virtual SkinPtr loadSkin(std::size_t i) const = 0;
   virtual void configureSkin(const SkinPtr& skin, std::size_t i) const = 0;
+  // applies only one (just changed) option
+  virtual void configureSkin(const SkinPtr& skin, std::size_t i, const QString& option) const = 0;
   virtual QStringList availableSkins() const = 0;
 
 public slots:
@@ -73,7 +77,10 @@ class ApplicationPrivate : public QObject
 
 public:
   using QObject::QObject;
+  ~ApplicationPrivate() { unsubscribeSkinOptions(); }
+
   using ConfigStorageType = ConfigStorage<QString, QString, QVariant>;
+  using SettingsBackendType = WriteBehindBackend<QString, QString, QVariant>;
 
   // config
   void initConfig();
@@ -119,12 +126,20 @@ public:
 
 public slots:
   void applyDebugOptions();
+  // writes all pending settings changes
+  void flushSettings();
 
 private:
   void createWindow(const QScreen* screen);
+  // must be called every time when windows are (re)created
+  void subscribeSkinOptions();
+  void unsubscribeSkinOptions();
+  void applySkinOption(std::size_t i, const QString& option);
 
 private:
   // config
+  std::shared_ptr<SettingsBackendType> _settings_backend;
+  QTimer _settings_flush_timer;
   std::shared_ptr<ConfigStorageType> _config_storage;
   std::unique_ptr<AppConfig> _app_config;
   std::unique_ptr<AppState> _app_state;
@@ -136,6 +151,7 @@ private:
   std::vector<std::unique_ptr<ClockWindow>> _windows;
   std::unique_ptr<MouseTracker> _mouse_tracker;
   std::unique_ptr<TimeSource> _time_src;
+  std::vector<std::size_t> _skin_option_subscriptions;   // per window
   std::unique_ptr<SkinManager> _skin_manager;
   std::unique_ptr<SettingsManager> _settings_manager;
   // updater
@@ -20,6 +20,23 @@ void ApplicationPrivate::initWindows(QScreen* primary_screen, QList<QScreen*> sc
   int windows_count = std::clamp(_app_config->global().getWindowsCount(), 1 , 8);
   for (int i = 0; i < windows_count; i++) createWindow(nullptr);
   std::ranges::for_each(_windows, [this](auto&& wnd) { configureWindow(wnd.get()); });
+  subscribeSkinOptions();
+}
+
+void ApplicationPrivate::subscribeSkinOptions()
+{
+  unsubscribeSkinOptions();
+  // apply changed skin options one by one instead of full reconfiguration
+  for (std::size_t i = 0; i < _windows.size(); i++)
+    _skin_option_subscriptions.push_back(_app_config->window(i).classicSkin().subscribe(
+        [this, i](const QString& option) { applySkinOption(i, option); }));
+}
+
+void ApplicationPrivate::unsubscribeSkinOptions()
+{
+  for (std::size_t i = 0; i < _skin_option_subscriptions.size(); i++)
+    _app_config->window(i).classicSkin().unsubscribe(_skin_option_subscriptions[i]);
+  _skin_option_subscriptions.clear();
 }
 
 #ifdef Q_OS_WINDOWS
@@ -59,6 +76,16 @@ void ApplicationPrivate::configureWindow(ClockWindow* wnd)
   }
 }
 
+void ApplicationPrivate::applySkinOption(std::size_t i, const QString& option)
+{
+  // skin is shared between all windows if config is shared, but
+  // settings dialog edits config of the window it was opened from,
+  // so option is applied to the shared skin to keep live preview
+  const std::size_t widx = _app_config->global().getConfigPerWindow() ? i : 0;
+  if (auto skin = window(widx)->skin())
+    _skin_manager->configureSkin(skin, i, option);
+}
+
 std::size_t ApplicationPrivate::window_index(const ClockWindow* w) const noexcept
 {
   for (std::size_t i = 0; i < _windows.size(); i++)
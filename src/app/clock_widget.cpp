@@ -8,9 +8,10 @@
 
 #include <QPainter>
 #include <QPaintEvent>
-#include <QPixmapCache>
 
+#include "resource.hpp"
 #include "skin.hpp"
+#include "trace.hpp"
 
 class ClockWidgetImpl : public SkinObserver,
                         public std::enable_shared_from_this<ClockWidgetImpl> {
@@ -27,7 +28,10 @@ public:
   void setSkin(std::shared_ptr<Skin> skin)
   {
     _skin = std::move(skin);
-    if (_skin) _skin->addObserver(weak_from_this());
+    if (_skin) {
+      _skin->setLocale(QLocale::system());
+      _skin->addObserver(weak_from_this());
+    }
     _glyph.reset();
     update();
   }
@@ -53,6 +57,13 @@ public:
     update();
   }
 
+  void updateLocale()
+  {
+    if (!_skin) return;
+    _skin->setLocale(QLocale::system());
+    update();
+  }
+
   void scale(qreal kx, qreal ky)
   {
     _kx = std::clamp(kx, 0.01, 10.0);
@@ -73,23 +84,31 @@ public:
     // so drop cache on system theme change (e.g. light/dark)
     if (_widget->palette() != _last_palette) {
       _last_palette = _widget->palette();
-      QPixmapCache::clear();
+      ClearCachedPixmaps();
     }
     if (!_glyph) return;
     p->setRenderHint(QPainter::Antialiasing);
     p->setRenderHint(QPainter::SmoothPixmapTransform);
     p->scale(_kx, _ky);
     p->translate(-_glyph->rect().topLeft());
+    FrameStageTimer _(_stats, FrameStats::Draw);
     _glyph->draw(p);
   }
 
+  FrameStats& stats() noexcept { return _stats; }
+
   void onConfigurationChanged() override { update(); }
 
 private:
   void update()
   {
     if (!_skin) return;
-    _glyph = _skin->process(_dt.toTimeZone(_tz));
+    const auto* last_glyph = _glyph.get();
+    {
+      FrameStageTimer _(_stats, FrameStats::Process);
+      _glyph = _skin->process(_dt.toTimeZone(_tz));
+    }
+    _stats.addLayoutLookup(_glyph && _glyph.get() == last_glyph);
     _widget->updateGeometry();
     _widget->update();
   }
@@ -103,6 +122,7 @@ private:
   qreal _kx = 1;
   qreal _ky = 1;
   QPalette _last_palette;   // used just to detect theme changes
+  FrameStats _stats;
 };
 
 
@@ -163,8 +183,28 @@ void ClockWidget::scale(qreal kx, qreal ky)
   _impl->d->scale(kx, ky);
 }
 
+void ClockWidget::changeEvent(QEvent* event)
+{
+  if (event->type() == QEvent::LocaleChange)
+    _impl->d->updateLocale();
+  QWidget::changeEvent(event);
+}
+
+const FrameStats& ClockWidget::frameStats() const
+{
+  return _impl->d->stats();
+}
+
+void ClockWidget::resetFrameStats()
+{
+  _impl->d->stats().reset();
+}
+
 void ClockWidget::paintEvent(QPaintEvent* event)
 {
+  // declared first to include painter destruction
+  FrameStageTimer _(_impl->d->stats(), FrameStats::Paint);
+  TRACE_SPAN("ClockWidget::paintEvent");
   QPainter p(this);
   _impl->d->draw(&p);
   event->accept();
@@ -13,6 +13,8 @@
 #include <QDateTime>
 #include <QTimeZone>
 
+#include "app/frame_stats.hpp"
+
 class Skin;
 
 class ClockWidget : public QWidget
@@ -31,6 +33,9 @@ public:
   void setSkin(std::shared_ptr<Skin> skin);
   std::shared_ptr<Skin> skin() const;
 
+  const FrameStats& frameStats() const;
+  void resetFrameStats();
+
 public slots:
   void setDateTime(const QDateTime& dt);
   void setTimeZone(const QTimeZone& tz);
@@ -40,6 +45,7 @@ public slots:
   void scale(qreal kx, qreal ky);
 
 protected:
+  void changeEvent(QEvent* event) override;
   void paintEvent(QPaintEvent* event) override;
 
 private:
@@ -90,6 +90,22 @@ std::shared_ptr<Skin> ClockWindow::skin() const
   return _impl->clock_widget->skin();
 }
 
+const FrameStats& ClockWindow::frameStats() const
+{
+  return _impl->clock_widget->frameStats();
+}
+
+void ClockWindow::resetFrameStats()
+{
+  _impl->clock_widget->resetFrameStats();
+}
+
+MemoryUsage ClockWindow::memoryUsage() const
+{
+  const auto s = skin();
+  return s ? s->memoryUsage() : MemoryUsage();
+}
+
 void ClockWindow::setDateTime(const QDateTime& utc)
 {
   _impl->clock_widget->setDateTime(utc);
@@ -17,7 +17,9 @@
 class QDateTime;
 class QTimeZone;
 
+class FrameStats;
 class Skin;
+struct MemoryUsage;
 
 class ClockWindow : public QWidget
 {
@@ -46,6 +48,12 @@ public:
   void setSkin(std::shared_ptr<Skin> skin);
   std::shared_ptr<Skin> skin() const;
 
+  const FrameStats& frameStats() const;
+  void resetFrameStats();
+
+  // memory held by window's skin
+  MemoryUsage memoryUsage() const;
+
 signals:
   void settingsDialogRequested();
   void aboutDialogRequested();
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// always-on frame timing statistics, it is cheap enough:
+// just a couple of steady_clock reads per measured stage
+class FrameStats final {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  enum Stage {
+    Process,  // Skin::process()
+    Draw,     // resource drawing
+    Paint,    // whole paint event
+    StagesCount
+  };
+
+  struct Summary {
+    Duration last = Duration::zero();
+    Duration average = Duration::zero();
+    Duration max = Duration::zero();
+  };
+
+  // the last N values are kept for each stage
+  static constexpr std::size_t history_size = 120;
+  // paint time histogram buckets upper bounds (in microseconds),
+  // the extra bucket is for everything longer than the last bound
+  static constexpr std::array<int, 8> histogram_bounds = {
+    250, 500, 1000, 2000, 4000, 8000, 16000, 33000
+  };
+  using Histogram = std::array<std::uint64_t, histogram_bounds.size() + 1>;
+
+  void add(Stage stage, Duration d) noexcept
+  {
+    auto& h = _history[stage];
+    h.values[h.next] = d;
+    h.next = (h.next + 1) % history_size;
+    if (h.count < history_size) ++h.count;
+
+    if (stage == Paint) {
+      ++_frames;
+      const auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+      std::size_t i = 0;
+      while (i < histogram_bounds.size() && us > histogram_bounds[i]) ++i;
+      ++_histogram[i];
+    }
+  }
+
+  // hit means that skin returned the same (memoized) layout
+  void addLayoutLookup(bool hit) noexcept
+  {
+    ++_lookups;
+    if (hit) ++_hits;
+  }
+
+  Summary summary(Stage stage) const noexcept
+  {
+    const auto& h = _history[stage];
+    Summary s;
+    if (h.count == 0) return s;
+    Duration total = Duration::zero();
+    for (std::size_t i = 0; i < h.count; i++) {
+      total += h.values[i];
+      if (h.values[i] > s.max) s.max = h.values[i];
+    }
+    s.last = h.values[(h.next + history_size - 1) % history_size];
+    s.average = total / h.count;
+    return s;
+  }
+
+  const Histogram& paintHistogram() const noexcept { return _histogram; }
+  std::uint64_t frames() const noexcept { return _frames; }
+
+  double layoutHitRate() const noexcept
+  {
+    return _lookups > 0 ? static_cast<double>(_hits) / _lookups : 0.0;
+  }
+
+  void reset() noexcept { *this = FrameStats(); }
+
+private:
+  struct History {
+    std::array<Duration, history_size> values = {};
+    std::size_t next = 0;
+    std::size_t count = 0;
+  };
+
+  std::array<History, StagesCount> _history = {};
+  Histogram _histogram = {};
+  std::uint64_t _frames = 0;
+  std::uint64_t _lookups = 0;
+  std::uint64_t _hits = 0;
+};
+
+// measures scope execution time
+class FrameStageTimer final {
+public:
+  FrameStageTimer(FrameStats& stats, FrameStats::Stage stage) noexcept
+    : _stats(stats)
+    , _stage(stage)
+    , _start(FrameStats::Clock::now())
+  {}
+
+  ~FrameStageTimer() { _stats.add(_stage, FrameStats::Clock::now() - _start); }
+
+  FrameStageTimer(const FrameStageTimer&) = delete;
+  FrameStageTimer& operator=(const FrameStageTimer&) = delete;
+
+private:
+  FrameStats& _stats;
+  FrameStats::Stage _stage;
+  FrameStats::Clock::time_point _start;
+};
@@ -7,7 +7,61 @@
 #include "debug_settings.hpp"
 #include "ui_debug_settings.h"
 
+#include <QDir>
+#include <QFontDatabase>
+#include <QPixmapCache>
+#include <QStandardPaths>
+#include <QTimer>
+
 #include "app/application_private.hpp"
+#include "app/frame_stats.hpp"
+#include "memory_usage.hpp"
+#include "resource.hpp"
+#include "trace.hpp"
+
+namespace {
+
+QString us(FrameStats::Duration d)
+{
+  return QString::number(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+}
+
+QString formatFrameStats(const FrameStats& stats)
+{
+  QString text;
+  auto add_stage = [&](const char* name, FrameStats::Stage stage) {
+    const auto s = stats.summary(stage);
+    text += QString("%1 last/avg/max, us: %2 / %3 / %4\n")
+            .arg(QLatin1String(name), -8).arg(us(s.last), us(s.average), us(s.max));
+  };
+  add_stage("process", FrameStats::Process);
+  add_stage("draw", FrameStats::Draw);
+  add_stage("paint", FrameStats::Paint);
+
+  text += QString("frames: %1, layout reused: %2%\n")
+          .arg(stats.frames()).arg(stats.layoutHitRate() * 100, 0, 'f', 1);
+
+  // paint time histogram, bucket upper bound: frames count
+  QStringList buckets;
+  const auto& histogram = stats.paintHistogram();
+  for (std::size_t i = 0; i < histogram.size(); i++) {
+    auto bound = i < FrameStats::histogram_bounds.size()
+                 ? QString("<%1").arg(FrameStats::histogram_bounds[i])
+                 : QString(">%1").arg(FrameStats::histogram_bounds.back());
+    buckets.append(QString("%1: %2").arg(bound).arg(histogram[i]));
+  }
+  text += buckets.join(QLatin1String(", "));
+  return text;
+}
+
+QString formatMemoryUsage(const MemoryUsage& usage)
+{
+  auto kib = [](std::size_t bytes) { return QString::number((bytes + 1023) / 1024); };
+  return QString("images: %1 KiB, svg: %2 KiB, fonts: %3 KiB, total: %4 KiB")
+         .arg(kib(usage.images), kib(usage.vector), kib(usage.fonts), kib(usage.total()));
+}
+
+} // namespace
 
 struct DebugSettings::Impl {
   ApplicationPrivate* app;
@@ -51,6 +105,19 @@ DebugSettings::DebugSettings(ApplicationPrivate* app, QWidget* parent)
   const auto all_cboxes = findChildren<QCheckBox*>();
   for (const auto& cbox : all_cboxes)
     connect(cbox, &QCheckBox::clicked, impl->app, &ApplicationPrivate::applyDebugOptions);
+
+  ui->frame_stats_label->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+  // stats are updated live while debug tab exists
+  auto timer = new QTimer(this);
+  connect(timer, &QTimer::timeout, this, &DebugSettings::updateFrameStats);
+  connect(timer, &QTimer::timeout, this, &DebugSettings::updateMemoryUsage);
+  timer->start(1000);
+  updateFrameStats();
+
+  ui->memory_usage_label->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+  updateMemoryUsage();
+
+  ui->trace_group->setChecked(trace::isEnabled());
 }
 
 DebugSettings::~DebugSettings()
@@ -121,3 +188,47 @@ void DebugSettings::on_draw_v_baseline_l_cb_clicked(bool checked)
   impl->config.setLayoutDebugFlags(impl->config.getLayoutDebugFlags().setFlag(debug::DrawVBaseline, checked));
   impl->markDirty();
 }
+
+void DebugSettings::on_frame_stats_reset_btn_clicked()
+{
+  for (const auto& wnd : impl->app->windows())
+    wnd->resetFrameStats();
+  updateFrameStats();
+}
+
+void DebugSettings::updateFrameStats()
+{
+  QStringList text;
+  const auto& windows = impl->app->windows();
+  for (std::size_t i = 0; i < windows.size(); i++)
+    text.append(QString("window %1\n%2").arg(i).arg(formatFrameStats(windows[i]->frameStats())));
+  ui->frame_stats_label->setText(text.join(QLatin1String("\n\n")));
+}
+
+void DebugSettings::updateMemoryUsage()
+{
+  QStringList text;
+  const auto& windows = impl->app->windows();
+  for (std::size_t i = 0; i < windows.size(); i++)
+    text.append(QString("window %1: %2").arg(i).arg(formatMemoryUsage(windows[i]->memoryUsage())));
+  // pixmap cache is shared by all windows
+  const auto cache = CachedPixmapsMemoryUsage().cache;
+  text.append(QString("pixmap cache: ~%1 KiB (limit %2 KiB)")
+              .arg((cache + 1023) / 1024).arg(QPixmapCache::cacheLimit()));
+  // the same skin assets are shared between windows
+  text.append(tr("shared assets are counted in each window"));
+  ui->memory_usage_label->setText(text.join(QLatin1Char('\n')));
+}
+
+void DebugSettings::on_trace_group_clicked(bool checked)
+{
+  if (checked) {
+    trace::start(QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+                 .absoluteFilePath(QLatin1String("digital_clock_trace.json")));
+    ui->trace_file_label->setText(tr("recording..."));
+  } else {
+    // tracing may be started not from here, but by environment variable
+    const auto trace_file = trace::stop();
+    ui->trace_file_label->setText(!trace_file.isEmpty() ? trace_file : tr("failed to write trace file"));
+  }
+}
@@ -36,6 +36,11 @@ private slots:
   void on_draw_v_baseline_i_cb_clicked(bool checked);
   void on_draw_v_baseline_l_cb_clicked(bool checked);
 
+  void on_frame_stats_reset_btn_clicked();
+  void on_trace_group_clicked(bool checked);
+  void updateFrameStats();
+  void updateMemoryUsage();
+
 private:
   Ui::DebugSettings* ui;
   struct Impl;
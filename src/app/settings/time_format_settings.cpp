@@ -114,8 +114,6 @@ void TimeFormatSettings::on_smaller_seconds_clicked(bool checked)
 
 void TimeFormatSettings::on_seconds_scale_factor_edit_valueChanged(int arg1)
 {
-  auto ssf = arg1 / 100.;
-  impl->skin->setTokenTransform("ss", QTransform::fromScale(ssf, ssf));
   impl->scfg->setSecondsScaleFactor(arg1);
 }
 
@@ -156,19 +154,16 @@ void TimeFormatSettings::on_format_help_btn_clicked()
 void TimeFormatSettings::on_format_apply_btn_clicked()
 {
   auto time_format = ui->format_edit->text();
-  impl->skin->setFormat(time_format);
   impl->scfg->setTimeFormat(time_format);
 }
 
 void TimeFormatSettings::on_custom_seps_edit_textEdited(const QString& arg1)
 {
-  impl->skin->setCustomSeparators(arg1);
   impl->scfg->setCustomSeparators(arg1);
 }
 
 void TimeFormatSettings::on_layout_cfg_edit_textEdited(const QString& arg1)
 {
-  impl->skin->setLayoutConfig(arg1);
   impl->scfg->setLayoutConfig(arg1);
 }
 
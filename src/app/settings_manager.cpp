@@ -6,12 +6,9 @@
 
 #include "settings_manager.hpp"
 
-#include <QDataStream>
 #include <QFile>
-#include <QVariantHash>
 
-static const quint32 file_type_magic = 0x44435335;  // DCS5, BE
-static const quint16 serialization_format = 0x515A; // QZ, BE
+#include "settings_export.hpp"
 
 SettingsManagerImpl::SettingsManagerImpl(ApplicationPrivate* app, QObject* parent)
   : SettingsManager(parent)
@@ -21,28 +18,9 @@ SettingsManagerImpl::SettingsManagerImpl(ApplicationPrivate* app, QObject* paren
 
 void SettingsManagerImpl::exportSettings(const QString& filename)
 {
-  QByteArray buffer;
-  QDataStream sout(&buffer, QIODevice::WriteOnly);
-  sout.setVersion(QDataStream::Qt_6_5);
-
-  QHash<QString, QVariantHash> settings;
-  for (const auto& [tag, ssec] : _app->config_storage()->exportSettings()) {
-    settings[tag] = QVariantHash(ssec.begin(), ssec.end());
-  }
-  sout << settings;
-
   QFile file(filename);
   if (!file.open(QIODevice::WriteOnly)) return;
-
-  QByteArray sdata = qCompress(buffer, 9);
-
-  QDataStream fout(&file);
-  fout.setVersion(QDataStream::Qt_6_5);
-  fout << file_type_magic;
-  fout << serialization_format;
-  fout << qChecksum(sdata);
-  fout << static_cast<quint32>(sdata.size());
-  fout.writeRawData(sdata.data(), sdata.size());
+  file.write(SerializeSettings(_app->config_storage()->exportSettings()));
 }
 
 void SettingsManagerImpl::importSettings(const QString& filename)
@@ -50,39 +28,10 @@ void SettingsManagerImpl::importSettings(const QString& filename)
   QFile file(filename);
   if (!file.open(QIODevice::ReadOnly)) return;
 
-  QDataStream fin(&file);
-  fin.setVersion(QDataStream::Qt_6_5);
-
-  quint32 magic;
-  quint16 dsfmt;
-  quint16 dcsum;
-  quint32 dsize;
-
-  fin >> magic >> dsfmt >> dcsum >> dsize;
-
-  if (magic != file_type_magic) return;
-  if (dsfmt != serialization_format) return;
-
-  QByteArray sdata(dsize, Qt::Initialization{});
-  if (fin.readRawData(sdata.data(), sdata.size()) != dsize) return;
-  if (qChecksum(sdata) != dcsum) return;
-
-  QByteArray buffer = qUncompress(sdata);
-  QDataStream sin(&buffer, QIODevice::ReadOnly);
-  sin.setVersion(QDataStream::Qt_6_5);
-
-  QHash<QString, QVariantHash> settings;
-  sin >> settings;
-
-  ApplicationPrivate::ConfigStorageType::SettingsData csettings;
-  for (auto titer = settings.begin(); titer != settings.end(); ++titer) {
-    auto& tsettings = csettings[titer.key()];
-    for (auto viter = titer.value().begin(); viter != titer.value().end(); ++viter) {
-      tsettings[viter.key()] = viter.value();
-    }
-  }
+  auto settings = DeserializeSettings(file.readAll());
+  if (!settings) return;
 
-  _app->config_storage()->importSettings(csettings);
+  _app->config_storage()->importSettings(std::move(*settings));
   _settings_imported = true;
   reconfigure();
 }
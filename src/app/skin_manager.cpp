@@ -8,27 +8,20 @@
 
 #include <algorithm>
 #include <iterator>
-#include <optional>
+#include <utility>
+#include <vector>
 
 #include <QApplication>
 #include <QDir>
 #include <QStandardPaths>
 
-#include "font_resource.hpp"
 #include "error_skin.hpp"
 #include "legacy_skin_loader.hpp"
 #include "modern_skin_loader.hpp"
+#include "shared_assets.hpp"
 
 namespace {
 
-std::optional<QString> tryLegacySkin(const QString& path)
-{
-  LegacySkinLoader loader(path);
-  if (loader.valid())
-    return loader.title();
-  return std::nullopt;
-}
-
 auto loadLegacySkin(const QString& skin_path)
 {
   LegacySkinLoader loader(skin_path);
@@ -36,19 +29,40 @@ auto loadLegacySkin(const QString& skin_path)
   return skin;
 }
 
-std::optional<QString> tryModernSkin(const QString& path)
+auto loadModernSkin(const QString& skin_path, const SkinCache& cache)
 {
-  ModernSkinLoader loader(path);
-  if (loader.valid())
-    return loader.title();
-  return std::nullopt;
+  ModernSkinLoader loader(skin_path);
+  auto skin = loader.skin(&cache);
+  return skin;
 }
 
-auto loadModernSkin(const QString& skin_path)
+using ClassicSkinOption = void (*)(ClassicSkin*, const ClassicSkinConfig&);
+
+// options are applied in this order on full configuration
+const std::vector<std::pair<QString, ClassicSkinOption>>& classic_skin_options()
 {
-  ModernSkinLoader loader(skin_path);
-  auto skin = loader.skin();
-  return skin;
+  using C = ClassicSkinConfig;
+  static const std::vector<std::pair<QString, ClassicSkinOption>> options = {
+    {C::TexturePerElementKey(), [](ClassicSkin* s, const C& c) { s->setTexturePerElement(c.getTexturePerElement()); }},
+    {C::TextureStretchKey(), [](ClassicSkin* s, const C& c) { s->setTextureStretch(c.getTextureStretch()); }},
+    {C::TextureKey(), [](ClassicSkin* s, const C& c) { s->setTexture(c.getTexture()); }},
+    {C::BackgroundPerElementKey(), [](ClassicSkin* s, const C& c) { s->setBackgroundPerElement(c.getBackgroundPerElement()); }},
+    {C::BackgroundStretchKey(), [](ClassicSkin* s, const C& c) { s->setBackgroundStretch(c.getBackgroundStretch()); }},
+    {C::BackgroundKey(), [](ClassicSkin* s, const C& c) { s->setBackground(c.getBackground()); }},
+    {C::TimeFormatKey(), [](ClassicSkin* s, const C& c) { s->setFormat(c.getTimeFormat()); }},
+    {C::OrientationKey(), [](ClassicSkin* s, const C& c) { s->setOrientation(c.getOrientation()); }},
+    {C::SpacingKey(), [](ClassicSkin* s, const C& c) { s->setSpacing(c.getSpacing()); }},
+    {C::CustomSeparatorsKey(), [](ClassicSkin* s, const C& c) { s->setCustomSeparators(c.getCustomSeparators()); }},
+    {C::IgnoreAdvanceXKey(), [](ClassicSkin* s, const C& c) { s->setIgnoreAdvanceX(c.getIgnoreAdvanceX()); }},
+    {C::IgnoreAdvanceYKey(), [](ClassicSkin* s, const C& c) { s->setIgnoreAdvanceY(c.getIgnoreAdvanceY()); }},
+    {C::GlyphBaseHeightKey(), [](ClassicSkin* s, const C& c) { s->setGlyphBaseHeight(c.getGlyphBaseHeight()); }},
+    {C::LayoutConfigKey(), [](ClassicSkin* s, const C& c) { s->setLayoutConfig(c.getLayoutConfig()); }},
+    {C::SecondsScaleFactorKey(), [](ClassicSkin* s, const C& c) {
+       qreal ssf = c.getSecondsScaleFactor() / 100.;
+       s->setTokenTransform("ss", QTransform::fromScale(ssf, ssf));
+     }},
+  };
+  return options;
 }
 
 } // namespace
@@ -56,13 +70,15 @@ auto loadModernSkin(const QString& skin_path)
 SkinManagerImpl::SkinManagerImpl(ApplicationPrivate* app, QObject* parent)
   : SkinManager(parent)
   , _app(app)
+  , _skin_cache(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                .absoluteFilePath(QLatin1StringView("skins")))
 {
   findSkins();
 }
 
 SkinManager::SkinPtr SkinManagerImpl::loadSkin(const QFont& font) const
 {
-  auto provider = std::make_shared<FontResourceFactory>(font);
+  auto provider = SharedFontResourceFactory(font);
   auto skin = std::make_shared<ClassicSkin>(std::move(provider));
   skin->setSupportsGlyphBaseHeight(false);
   skin->setSupportsCustomSeparator(true);
@@ -77,7 +93,7 @@ SkinManager::SkinPtr SkinManagerImpl::loadSkin(const QString& skin_name) const
       case SkinType::Legacy:
         return loadLegacySkin(iter.value().path);
       case SkinType::Modern:
-        return loadModernSkin(iter.value().path);
+        return loadModernSkin(iter.value().path, _skin_cache);
     }
   }
   return std::make_unique<ErrorSkin>();
@@ -103,6 +119,12 @@ void SkinManagerImpl::configureSkin(const SkinPtr& skin, std::size_t i) const
   skin->visit(visitor);
 }
 
+void SkinManagerImpl::configureSkin(const SkinPtr& skin, std::size_t i, const QString& option) const
+{
+  SkinConfigurator visitor(_app->app_config()->window(i), option);
+  skin->visit(visitor);
+}
+
 QStringList SkinManagerImpl::availableSkins() const
 {
   QStringList skins = _skins.keys();
@@ -112,8 +134,6 @@ QStringList SkinManagerImpl::availableSkins() const
 
 void SkinManagerImpl::findSkins()
 {
-  _skins.clear();
-
   using namespace Qt::Literals::StringLiterals;
   QStringList search_paths = {
     u":/skins"_s,
@@ -133,51 +153,15 @@ void SkinManagerImpl::findSkins()
                  std::back_inserter(search_paths),
                  [](const QString& path) { return QDir(path).absoluteFilePath(u"skins"_s); });
 
-  constexpr std::pair<SkinType, std::optional<QString>(*)(const QString&)> validators[] = {
-    {SkinType::Legacy, &tryLegacySkin},
-    {SkinType::Modern, &tryModernSkin},
-  };
-
-  for (const auto& path : std::as_const(search_paths)) {
-    QDir dir(path);
-    if (!dir.exists())
-      continue;
-    const auto items = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    for (const auto& item : items) {
-      auto skin_path = dir.absoluteFilePath(item);
-      for (const auto& [type, validator] : validators) {
-        if (auto name = (*validator)(skin_path)) {
-          _skins[*name] = {type, skin_path};
-          break;
-        }
-      }
-    }
-  }
+  _skins = FindSkins(search_paths);
 }
 
 void SkinConfigurator::visit(ClassicSkin* skin)
 {
   const auto& scfg = _wnd_config.classicSkin();
 
-  skin->setTexturePerElement(scfg.getTexturePerElement());
-  skin->setTextureStretch(scfg.getTextureStretch());
-  skin->setTexture(scfg.getTexture());
-  skin->setBackgroundPerElement(scfg.getBackgroundPerElement());
-  skin->setBackgroundStretch(scfg.getBackgroundStretch());
-  skin->setBackground(scfg.getBackground());
-
-  skin->setFormat(scfg.getTimeFormat());
-  skin->setOrientation(scfg.getOrientation());
-  skin->setSpacing(scfg.getSpacing());
-  skin->setCustomSeparators(scfg.getCustomSeparators());
-
-  skin->setIgnoreAdvanceX(scfg.getIgnoreAdvanceX());
-  skin->setIgnoreAdvanceY(scfg.getIgnoreAdvanceY());
-
-  skin->setGlyphBaseHeight(scfg.getGlyphBaseHeight());
-
-  skin->setLayoutConfig(scfg.getLayoutConfig());
-
-  qreal ssf = scfg.getSecondsScaleFactor() / 100.;
-  skin->setTokenTransform("ss", QTransform::fromScale(ssf, ssf));
+  SkinUpdateGuard _(*skin);
+  for (const auto& [option, apply] : classic_skin_options())
+    if (_option.isEmpty() || _option == option)
+      apply(skin, scfg);
 }
@@ -8,13 +8,17 @@
 
 #include "application_private.hpp"
 
+#include "skin_cache.hpp"
+#include "skin_finder.hpp"
 #include "skin_visitor.hpp"
 
 class SkinConfigurator final : public SkinVisitor
 {
 public:
-  explicit SkinConfigurator(const WindowConfig& wnd_cfg) noexcept
+  // empty option means 'all options'
+  explicit SkinConfigurator(const WindowConfig& wnd_cfg, QString option = {}) noexcept
     : _wnd_config(wnd_cfg)
+    , _option(std::move(option))
   {}
 
   void visit(ClassicSkin* skin) override;
@@ -23,6 +27,7 @@ public:
 
 private:
   const WindowConfig& _wnd_config;
+  QString _option;
 };
 
 // skin manager is "integral part" of application
@@ -39,6 +44,7 @@ public:
   SkinPtr loadSkin(const QString& skin_name) const override;
   SkinPtr loadSkin(std::size_t i) const override;
   void configureSkin(const SkinPtr& skin, std::size_t i) const override;
+  void configureSkin(const SkinPtr& skin, std::size_t i, const QString& option) const override;
   QStringList availableSkins() const override;
 
 public slots:
@@ -47,15 +53,6 @@ public slots:
 private:
   ApplicationPrivate* _app;
 
-  enum class SkinType {
-    Legacy,
-    Modern,
-  };
-
-  struct LoaderInfo {
-    SkinType type;
-    QString path;
-  };
-
-  QHash<QString, LoaderInfo> _skins;
+  SkinLocations _skins;
+  SkinCache _skin_cache;
 };
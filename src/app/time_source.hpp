@@ -8,39 +8,87 @@
 
 #include <QObject>
 
+#include <chrono>
+
 #include <QDateTime>
 #include <QTimer>
 
+#include "trace.hpp"
+
 class TimeSource : public QObject
 {
   Q_OBJECT
 
 public:
-  explicit TimeSource(QObject* parent = nullptr)
-    : QObject(parent)
+  using QObject::QObject;
+
+  // current UTC time
+  virtual QDateTime now() const = 0;
+
+signals:
+  // provides current UTC time, interval is unspecified
+  void timeChanged(const QDateTime& dt);
+
+protected:
+  void tick()
+  {
+    // includes all connected slots (i.e. windows update)
+    TRACE_SPAN("TimeSource::tick");
+    emit timeChanged(now());
+  }
+};
+
+
+// real time, ticks twice a second
+class SystemTimeSource final : public TimeSource
+{
+public:
+  explicit SystemTimeSource(QObject* parent = nullptr)
+    : TimeSource(parent)
   {
-    connect(&_timer, &QTimer::timeout, this, &TimeSource::onTimeout);
+    connect(&_timer, &QTimer::timeout, this, &SystemTimeSource::tick);
     using namespace std::chrono_literals;
     _timer.start(500ms);
   }
 
-  ~TimeSource()
+  ~SystemTimeSource()
   {
     _timer.stop();
   }
 
-  QDateTime now() const { return QDateTime::currentDateTimeUtc(); }
+  QDateTime now() const override { return QDateTime::currentDateTimeUtc(); }
+
+private:
+  QTimer _timer;
+};
 
-signals:
-  // provides current UTC time, interval is unspecified
-  void timeChanged(const QDateTime& dt);
 
-private slots:
-  void onTimeout()
+// virtual time, ticks only when requested, so any time sequence
+// (e.g. whole day, DST transitions, leap days) can be replayed
+// as fast as connected objects can handle it
+class SimulatedTimeSource final : public TimeSource
+{
+public:
+  SimulatedTimeSource(const QDateTime& start, std::chrono::milliseconds step,
+                      QObject* parent = nullptr)
+    : TimeSource(parent)
+    , _now(start.toUTC())
+    , _step(step)
+  {}
+
+  QDateTime now() const override { return _now; }
+
+  // sets current time and ticks
+  void setTime(const QDateTime& dt)
   {
-    emit timeChanged(now());
+    _now = dt.toUTC();
+    tick();
   }
 
+  // moves time forward by one step and ticks
+  void advance() { setTime(_now.addMSecs(_step.count())); }
+
 private:
-  QTimer _timer;
+  QDateTime _now;
+  std::chrono::milliseconds _step;
 };
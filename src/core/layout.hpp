@@ -107,6 +107,13 @@ public:
 
   const auto& items() const noexcept { return _res->items(); }
 
+  // just a hint, allows to avoid reallocations when items count is known
+  void reserve(std::size_t count)
+  {
+    doReserve(count);
+    _res->reserve(count);
+  }
+
 protected:
   Layout();
 
@@ -118,6 +125,7 @@ protected:
   }
 
   virtual void doAddItem(std::shared_ptr<LayoutItem> item) = 0;
+  virtual void doReserve(std::size_t count) { Q_UNUSED(count); }
   // returns (ax,ay)
   virtual std::pair<qreal, qreal> doBuildLayout() = 0;
 
@@ -139,6 +147,8 @@ private:
       _items.push_back(std::move(item));
     }
 
+    void reserve(std::size_t count) { _items.reserve(count); }
+
     using Items = std::vector<std::shared_ptr<LayoutItem>>;
     const Items& items() const noexcept { return _items; }
 
@@ -9,8 +9,11 @@
 #include <algorithm>
 #include <iterator>
 
+#include "trace.hpp"
+
 std::pair<qreal, qreal> LinearLayout::doBuildLayout()
 {
+  TRACE_SPAN("LinearLayout::build");
   Q_ASSERT(!_items.empty());
   resetPosInOppositeDirection();
   auto [omin, omax] = resizeItems();
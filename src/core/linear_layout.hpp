@@ -54,6 +54,12 @@ protected:
     _items_alignment.push_back(Qt::AlignBaseline | Qt::AlignJustify);
   }
 
+  void doReserve(std::size_t count) override
+  {
+    _items.reserve(count);
+    _items_alignment.reserve(count);
+  }
+
   std::pair<qreal, qreal> doBuildLayout() override;
 
 private:
@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// estimated memory usage by category, in bytes,
+// values are rough estimations, not exact numbers
+struct MemoryUsage {
+  std::size_t images = 0;   // decoded raster images
+  std::size_t vector = 0;   // parsed vector images (SVG documents)
+  std::size_t fonts = 0;    // loaded custom fonts
+  std::size_t cache = 0;    // rendered pixmaps in pixmap cache
+
+  std::size_t total() const noexcept { return images + vector + fonts + cache; }
+
+  MemoryUsage& operator+=(const MemoryUsage& other) noexcept
+  {
+    images += other.images;
+    vector += other.vector;
+    fonts += other.fonts;
+    cache += other.cache;
+    return *this;
+  }
+
+  friend MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) noexcept
+  {
+    return lhs += rhs;
+  }
+};
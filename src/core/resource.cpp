@@ -6,9 +6,79 @@
 
 #include "resource.hpp"
 
+#include <list>
+#include <utility>
+
+#include <QHash>
 #include <QPainter>
 #include <QPixmapCache>
 
+#include "trace.hpp"
+
+namespace {
+
+// QPixmapCache doesn't report its usage and evicts entries silently,
+// so inserted pixmaps are tracked in the same LRU order as the cache
+// uses and dropped when their total size exceeds the cache limit,
+// the cache itself is never queried to keep its order untouched
+class CachedPixmaps final {
+public:
+  void insert(const QString& key, qint64 size)
+  {
+    remove(key);
+    _lru.push_front({key, size});
+    _entries[key] = _lru.begin();
+    _total += size;
+    // QPixmapCache limit is in KiB
+    const qint64 limit = qint64(QPixmapCache::cacheLimit()) * 1024;
+    while (_total > limit && !_lru.empty()) {
+      _total -= _lru.back().second;
+      _entries.remove(_lru.back().first);
+      _lru.pop_back();
+    }
+  }
+
+  // the cache moves found entry to the front, so do the same
+  void touch(const QString& key)
+  {
+    if (auto iter = _entries.find(key); iter != _entries.end())
+      _lru.splice(_lru.begin(), _lru, iter.value());
+  }
+
+  void clear()
+  {
+    _lru.clear();
+    _entries.clear();
+    _total = 0;
+  }
+
+  qint64 total() const noexcept { return _total; }
+
+private:
+  void remove(const QString& key)
+  {
+    if (auto iter = _entries.find(key); iter != _entries.end()) {
+      _total -= iter.value()->second;
+      _lru.erase(iter.value());
+      _entries.erase(iter);
+    }
+  }
+
+private:
+  using Entries = std::list<std::pair<QString, qint64>>;
+  Entries _lru;   // most recently used first
+  QHash<QString, Entries::iterator> _entries;
+  qint64 _total = 0;
+};
+
+CachedPixmaps& cachedPixmaps()
+{
+  static CachedPixmaps pixmaps;
+  return pixmaps;
+}
+
+} // namespace
+
 void CachedResource::draw(QPainter* p)
 {
   if (rect().isEmpty())
@@ -24,7 +94,10 @@ void CachedResource::draw(QPainter* p)
                 .arg(sz.width()).arg(sz.height());
   QPixmap pxm;
 
-  if (!QPixmapCache::find(key, &pxm)) {
+  if (QPixmapCache::find(key, &pxm)) {
+    cachedPixmaps().touch(key);
+  } else {
+    TRACE_SPAN("CachedResource::miss");
     pxm = QPixmap(sz);
     pxm.setDevicePixelRatio(p->device()->devicePixelRatioF());
     pxm.fill(Qt::transparent);
@@ -37,10 +110,24 @@ void CachedResource::draw(QPainter* p)
       pp.setTransform(ext_tr, true);
       ResourceDecorator::draw(&pp);
     }
-    QPixmapCache::insert(key, pxm);
+    if (QPixmapCache::insert(key, pxm))
+      cachedPixmaps().insert(key, qint64(pxm.width()) * pxm.height() * pxm.depth() / 8);
   }
   p->resetTransform();
   p->translate(br.topLeft());
   p->drawPixmap(0, 0, pxm);
   p->restore();
 }
+
+MemoryUsage CachedPixmapsMemoryUsage()
+{
+  MemoryUsage usage;
+  usage.cache = cachedPixmaps().total();
+  return usage;
+}
+
+void ClearCachedPixmaps()
+{
+  QPixmapCache::clear();
+  cachedPixmaps().clear();
+}
@@ -10,6 +10,8 @@
 
 #include <QRect>
 
+#include "memory_usage.hpp"
+
 class QPainter;
 
 // "skin resource"
@@ -28,6 +30,9 @@ public:
   virtual void draw(QPainter* p) = 0;
 
   virtual size_t cacheKey() const = 0;
+
+  // memory held by resource itself, nothing by default
+  virtual MemoryUsage memoryUsage() const { return {}; }
 };
 
 
@@ -45,6 +50,8 @@ public:
 
   size_t cacheKey() const override { return _r->cacheKey(); }
 
+  MemoryUsage memoryUsage() const override { return _r->memoryUsage(); }
+
 private:
   std::shared_ptr<Resource> _r;
 };
@@ -57,6 +64,16 @@ public:
   void draw(QPainter* p) override;
 };
 
+// estimated memory used by pixmaps rendered by all CachedResource
+// instances and still present in QPixmapCache, reported as
+// MemoryUsage::cache, it never exceeds QPixmapCache::cacheLimit(),
+// but may count entries removed from the cache not by ClearCachedPixmaps(),
+// must be called from GUI thread, as any QPixmapCache function
+MemoryUsage CachedPixmapsMemoryUsage();
+// clears QPixmapCache, use it instead of QPixmapCache::clear()
+// to keep CachedPixmapsMemoryUsage() estimate accurate
+void ClearCachedPixmaps();
+
 
 // resource just with given geometry,
 // no draw() implementation is provided
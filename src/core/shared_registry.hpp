@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <QHash>
+
+// registry of shared immutable objects, objects are kept alive only while
+// anybody else holds them, registry itself holds only weak references
+// not thread-safe, intended to be used as process-wide storage in GUI thread
+template<typename Key, typename T>
+class SharedRegistry final {
+public:
+  // returns existing object for the given key or creates new one
+  template<typename Factory>
+  std::shared_ptr<T> get(const Key& key, Factory&& create)
+  {
+    if (auto obj = _objects.value(key).lock())
+      return obj;
+
+    std::shared_ptr<T> obj = std::invoke(std::forward<Factory>(create));
+    _objects.removeIf([](typename Objects::iterator i) { return i.value().expired(); });
+    _objects.insert(key, obj);
+    return obj;
+  }
+
+private:
+  using Objects = QHash<Key, std::weak_ptr<T>>;
+  Objects _objects;
+};
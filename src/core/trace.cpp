@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "trace.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <QSaveFile>
+
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> enabled = false;
+
+} // namespace detail
+
+namespace {
+
+struct Event {
+  const char* name;
+  std::int64_t start;
+  std::int64_t end;
+};
+
+// events are dropped when buffer is full
+constexpr std::size_t buffer_capacity = 1 << 16;
+
+// buffers are never reset by start(), it just begins new session,
+// each thread drops its own events of previous session on record
+std::atomic<std::uint32_t> session = 0;
+
+// session in the high half, published events count in the low half
+constexpr std::uint64_t packState(std::uint32_t s, std::size_t n) noexcept
+{
+  return (std::uint64_t(s) << 32) | n;
+}
+
+// events count published for given session
+constexpr std::size_t stateSize(std::uint64_t state, std::uint32_t s) noexcept
+{
+  return (state >> 32) == s ? static_cast<std::size_t>(state & 0xffffffff) : 0;
+}
+
+// written only by its own thread without any locks,
+// reader uses only events published by state
+struct ThreadBuffer {
+  std::unique_ptr<Event[]> events = std::make_unique<Event[]>(buffer_capacity);
+  std::atomic<std::uint64_t> state = 0;
+  int tid = 0;
+};
+
+// guards buffers list and file name, never used on recording
+std::mutex trace_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+QString trace_filename;
+
+const auto epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer& threadBuffer()
+{
+  thread_local const auto buffer = [] {
+    auto b = std::make_shared<ThreadBuffer>();
+    std::lock_guard _(trace_mutex);
+    b->tid = static_cast<int>(buffers.size()) + 1;
+    buffers.push_back(b);
+    return b;
+  }();
+  return *buffer;
+}
+
+// in microseconds, as trace format requires
+QByteArray us(std::int64_t ns)
+{
+  return QByteArray::number(ns / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+namespace detail {
+
+std::int64_t now() noexcept
+{
+  auto d = std::chrono::steady_clock::now() - epoch;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+void record(const char* name, std::int64_t start, std::int64_t end) noexcept
+{
+  if (!isEnabled()) return;
+  auto& b = threadBuffer();
+  // events recorded during stale session are never published
+  const auto s = session.load(std::memory_order_acquire);
+  const auto i = stateSize(b.state.load(std::memory_order_relaxed), s);
+  if (i >= buffer_capacity) return;
+  b.events[i] = {name, start, end};
+  b.state.store(packState(s, i + 1), std::memory_order_release);
+}
+
+} // namespace detail
+
+void start(const QString& filename)
+{
+  std::lock_guard _(trace_mutex);
+  session.fetch_add(1, std::memory_order_release);
+  trace_filename = filename;
+  detail::enabled.store(true, std::memory_order_release);
+}
+
+QString stop()
+{
+  detail::enabled.store(false, std::memory_order_release);
+
+  std::lock_guard _(trace_mutex);
+  if (trace_filename.isEmpty()) return {};
+
+  const auto filename = std::exchange(trace_filename, QString());
+  QSaveFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) return {};
+
+  const auto s = session.load(std::memory_order_relaxed);
+
+  QByteArray data = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  bool first = true;
+  auto add_event = [&](const QByteArray& event) {
+    if (!first) data += ",\n";
+    data += event;
+    first = false;
+  };
+
+  for (const auto& b : buffers) {
+    const auto tid = QByteArray::number(b->tid);
+    add_event(R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + tid +
+              R"(,"args":{"name":"thread )" + tid + R"("}})");
+    const auto size = stateSize(b->state.load(std::memory_order_acquire), s);
+    for (std::size_t i = 0; i < size; i++) {
+      const auto& e = b->events[i];
+      add_event(R"({"name":")" + QByteArray(e.name) +
+                R"(","cat":"render","ph":"X","pid":1,"tid":)" + tid +
+                R"(,"ts":)" + us(e.start) + R"(,"dur":)" + us(e.end - e.start) + "}");
+    }
+  }
+
+  data += "]}\n";
+
+  file.write(data);
+  return file.commit() ? filename : QString();
+}
+
+} // namespace trace
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <QString>
+
+// opt-in spans recording in Chrome trace event format,
+// result can be opened in chrome://tracing or Perfetto UI
+namespace trace {
+
+static constexpr const char* const TraceFileVar =
+    "DIGITAL_CLOCK_NEXT_TRACE_FILE";
+
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+std::int64_t now() noexcept;
+void record(const char* name, std::int64_t start, std::int64_t end) noexcept;
+
+} // namespace detail
+
+inline bool isEnabled() noexcept
+{
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+// starts recording, all previously recorded events are dropped
+void start(const QString& filename);
+// stops recording and writes trace file, returns written file name,
+// empty string if tracing was not started or on write error
+QString stop();
+
+// just one atomic flag check if tracing is disabled
+class Span final {
+public:
+  explicit Span(const char* name) noexcept
+    : _name(name)
+    , _start(isEnabled() ? detail::now() : -1)
+  {}
+
+  ~Span()
+  {
+    if (_start >= 0) detail::record(_name, _start, detail::now());
+  }
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+private:
+  const char* _name;
+  std::int64_t _start;
+};
+
+} // namespace trace
+
+#define TRACE_SPAN_CONCAT_IMPL(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT_IMPL(a, b)
+// name must be a string with static storage duration (e.g. literal)
+#define TRACE_SPAN(name) trace::Span TRACE_SPAN_CONCAT(trace_span_, __LINE__)(name)
@@ -8,8 +8,11 @@
 
 #include <QPainter>
 
+#include "trace.hpp"
+
 void NewSurfaceDecorator::draw(QPainter* p)
 {
+  TRACE_SPAN("NewSurface::draw");
   p->save();
   QSize sz(p->device()->width(), p->device()->height());
   sz *= p->device()->devicePixelRatioF();
@@ -6,14 +6,87 @@
 
 #include "image_resource.hpp"
 
+#include <QFileInfo>
 #include <QPainter>
+#include <QResource>
 
 void RasterImageResource::draw(QPainter* p)
 {
+  if (m_icon.isNull() && !m_filename.isEmpty())
+    m_icon = QIcon(m_filename);
   p->drawPixmap(rect().toRect(), m_icon.pixmap(m_size));
 }
 
+MemoryUsage RasterImageResource::memoryUsage() const
+{
+  MemoryUsage usage;
+  if (m_icon.isNull())
+    return usage;
+  // all images are assumed 32 bpp, even if they are not
+  const auto sizes = m_icon.availableSizes();
+  for (const auto& sz : sizes)
+    usage.images += std::size_t(sz.width()) * sz.height() * 4;
+  return usage;
+}
+
 void SvgImageResource::draw(QPainter* p)
 {
+  if (!m_renderer)
+    m_renderer = createRenderer(m_filename, &m_source_size);
   m_renderer->render(p, rect());
 }
+
+MemoryUsage SvgImageResource::memoryUsage() const
+{
+  MemoryUsage usage;
+  // parsed document size is unknown, but it is not less than its source
+  if (m_renderer)
+    usage.vector = m_source_size;
+  return usage;
+}
+
+std::unique_ptr<QSvgRenderer> SvgImageResource::createRenderer(const QString& filename,
+                                                               qint64* source_size)
+{
+  // uncompressed resources (e.g. from mapped skin packs)
+  // can be parsed right from memory, without any copying
+  if (filename.startsWith(u':')) {
+    QResource res(filename);
+    if (res.isValid() && res.compressionAlgorithm() == QResource::NoCompression) {
+      auto data = QByteArray::fromRawData(reinterpret_cast<const char*>(res.data()), res.size());
+      *source_size = data.size();
+      return std::make_unique<QSvgRenderer>(data);
+    }
+  }
+  *source_size = QFileInfo(filename).size();
+  return std::make_unique<QSvgRenderer>(filename);
+}
+
+std::shared_ptr<ImageResource> CreateImageResource(const QString& filename, ImageSizeMap* sizes)
+{
+  QFileInfo fi(filename);
+  const auto ext = fi.suffix().toLower();
+
+  if (sizes) {
+    if (auto iter = sizes->constFind(filename); iter != sizes->constEnd()) {
+      if (ext == "svg")
+        return std::make_shared<SvgImageResource>(filename, iter.value());
+      if (ext == "png")
+        return std::make_shared<RasterImageResource>(filename, iter.value().toSize());
+    }
+  }
+
+  if (!fi.exists())
+    return nullptr;
+
+  std::shared_ptr<ImageResource> resource;
+  if (ext == "svg")
+    resource = std::make_shared<SvgImageResource>(filename);
+  if (ext == "png")
+    resource = std::make_shared<RasterImageResource>(filename);
+
+  if (resource && sizes)
+    sizes->insert(filename, resource->rect().size());
+
+  return resource;
+}
@@ -10,6 +10,7 @@
 
 #include <memory>
 
+#include <QHash>
 #include <QIcon>
 #include <QSvgRenderer>
 
@@ -58,9 +59,21 @@ public:
     initGeometry(m_size);
   }
 
+  // image size is known, so image loading is deferred until first draw
+  RasterImageResource(const QString& filename, const QSize& size)
+    : ImageResource(filename)
+    , m_filename(filename)
+    , m_size(size)
+  {
+    initGeometry(m_size);
+  }
+
   void draw(QPainter* p) override;
 
+  MemoryUsage memoryUsage() const override;
+
 private:
+  QString m_filename;   // set only when loading is deferred
   QIcon m_icon;   // QIcon perfectly handles HighDPI
   QSize m_size;   // 100% image size
 };
@@ -70,13 +83,40 @@ class SvgImageResource : public ImageResource {
 public:
   explicit SvgImageResource(const QString& filename)
     : ImageResource(filename)
-    , m_renderer(std::make_unique<QSvgRenderer>(filename))
+    , m_renderer(createRenderer(filename, &m_source_size))
   {
     initGeometry(m_renderer->defaultSize());
   }
 
+  // image size is known, so parsing is deferred until first draw
+  SvgImageResource(const QString& filename, const QSizeF& size)
+    : ImageResource(filename)
+    , m_filename(filename)
+  {
+    initGeometry(size);
+  }
+
   void draw(QPainter* p) override;
 
+  MemoryUsage memoryUsage() const override;
+
+private:
+  static std::unique_ptr<QSvgRenderer> createRenderer(const QString& filename,
+                                                      qint64* source_size);
+
 private:
+  QString m_filename;   // set only when parsing is deferred
+  qint64 m_source_size = 0;   // must be initialized before renderer
   std::unique_ptr<QSvgRenderer> m_renderer;
 };
+
+
+// default (100%) image sizes by file path,
+// known size allows to avoid image loading at creation time
+using ImageSizeMap = QHash<QString, QSizeF>;
+
+// creates resource of appropriate type based on file extension,
+// image size is taken from sizes map if it is there, otherwise
+// image is loaded immediately and its size is added to the map
+std::shared_ptr<ImageResource> CreateImageResource(const QString& filename,
+                                                   ImageSizeMap* sizes = nullptr);
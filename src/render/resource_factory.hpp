@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <span>
+
 #include <QHash>
 
 #include "resource.hpp"
@@ -16,19 +20,49 @@ public:
 
   std::shared_ptr<Resource> item(char32_t ch) const
   {
+    // fast path for the most used characters, just an index
+    if (ch < _latin1.size()) {
+      if (!_latin1_created.test(ch)) {
+        _latin1[ch] = create(ch);
+        _latin1_created.set(ch);
+      }
+      return _latin1[ch];
+    }
+
     auto& resource = _cache[ch];
     if (!resource) resource = create(ch);
     return resource;
   }
 
+  // creates resources for given characters in advance
+  void prewarm(std::span<const char32_t> chars) const
+  {
+    for (auto ch : chars) item(ch);
+  }
+
   virtual qreal ascent() const = 0;
   virtual qreal descent() const = 0;
 
   inline qreal height() const { return ascent() + descent(); }
 
+  // memory held by all resources created so far
+  virtual MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    for (const auto& r : _latin1)
+      if (r) usage += r->memoryUsage();
+    for (const auto& r : _cache)
+      if (r) usage += r->memoryUsage();
+    return usage;
+  }
+
 protected:
   virtual std::shared_ptr<Resource> create(char32_t ch) const = 0;
 
 private:
+  // Latin-1 characters, resource may be null if character is not supported
+  mutable std::array<std::shared_ptr<Resource>, 256> _latin1;
+  mutable std::bitset<256> _latin1_created;
+  // all other characters
   mutable QHash<char32_t, std::shared_ptr<Resource>> _cache;
 };
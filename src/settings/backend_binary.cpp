@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "backend_binary.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QVariantHash>
+
+namespace {
+
+constexpr quint32 file_magic = 0x44435342;  // "DCSB"
+constexpr quint16 file_version = 1;
+
+constexpr auto stream_version = QDataStream::Qt_6_4;
+
+} // namespace
+
+BackendBinary::BackendBinary(QString filename)
+  : _filename(std::move(filename))
+{
+  _loaded = readFile();
+  _broken = !_loaded && QFile::exists(_filename);
+}
+
+BackendBinary::~BackendBinary()
+{
+  flush();
+}
+
+bool BackendBinary::backupBroken(const QString& backup_filename)
+{
+  if (!_broken)
+    return false;
+  if (QFile::exists(backup_filename) && !QFile::remove(backup_filename))
+    return false;
+  if (!QFile::rename(_filename, backup_filename))
+    return false;
+  _broken = false;
+  return true;
+}
+
+void BackendBinary::flush()
+{
+  if (_dirty && writeFile())
+    _dirty = false;
+}
+
+BackendBinary::SettingsMap BackendBinary::tagSettings(const QString& tag) const
+{
+  auto iter = _settings.find(tag);
+  return iter != _settings.end() ? iter->second : SettingsMap();
+}
+
+void BackendBinary::setValue(const QString& tag, const QString& k, const QVariant& v)
+{
+  _settings[tag][k] = v;
+  _dirty = true;
+}
+
+std::optional<QVariant> BackendBinary::value(const QString& tag, const QString& k) const
+{
+  auto titer = _settings.find(tag);
+  if (titer == _settings.end())
+    return std::nullopt;
+
+  auto viter = titer->second.find(k);
+  if (viter == titer->second.end())
+    return std::nullopt;
+
+  return viter->second;
+}
+
+void BackendBinary::migrateFrom(const BackendType& other)
+{
+  if (_broken)
+    return;
+  _settings = other.allSettings();
+  _loaded = writeFile();
+  _dirty = !_loaded;
+}
+
+QJsonDocument BackendBinary::toJson() const
+{
+  QJsonObject root;
+  for (const auto& [tag, settings] : _settings) {
+    QJsonObject jtag;
+    for (const auto& [key, value] : settings) {
+      auto jvalue = QJsonValue::fromVariant(value);
+      if (jvalue.isNull() && !value.isNull())
+        jvalue = QString::fromLatin1(value.typeName());
+      jtag.insert(key, jvalue);
+    }
+    root.insert(tag, jtag);
+  }
+  return QJsonDocument(root);
+}
+
+bool BackendBinary::readFile()
+{
+  QFile file(_filename);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  // the whole file is read at once, it is small enough
+  const QByteArray buffer = file.readAll();
+  QDataStream in(buffer);
+  in.setVersion(stream_version);
+
+  quint32 magic = 0;
+  quint16 version = 0;
+  in >> magic >> version;
+  if (magic != file_magic || version != file_version)
+    return false;
+
+  QHash<QString, QVariantHash> settings;
+  in >> settings;
+  if (in.status() != QDataStream::Ok)
+    return false;
+
+  _settings.clear();
+  for (auto titer = settings.cbegin(); titer != settings.cend(); ++titer) {
+    auto& tsettings = _settings[titer.key()];
+    for (auto viter = titer.value().cbegin(); viter != titer.value().cend(); ++viter)
+      tsettings[viter.key()] = viter.value();
+  }
+  return true;
+}
+
+bool BackendBinary::writeFile() const
+{
+  // keep unreadable file untouched, it may be recovered
+  if (_broken)
+    return false;
+
+  QHash<QString, QVariantHash> settings;
+  for (const auto& [tag, ssec] : _settings)
+    settings[tag] = QVariantHash(ssec.begin(), ssec.end());
+
+  QSaveFile file(_filename);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+
+  QDataStream out(&file);
+  out.setVersion(stream_version);
+  out << file_magic << file_version << settings;
+
+  // file is replaced only if everything was written successfully
+  return out.status() == QDataStream::Ok && file.commit();
+}
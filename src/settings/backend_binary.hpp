@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "core/settings.hpp"
+
+#include <QJsonDocument>
+#include <QString>
+#include <QVariant>
+
+/**
+ * @brief Settings backend with compact binary storage
+ *
+ * All settings are kept in memory, file is read once on construction
+ * and is completely rewritten (atomically) on flush() if anything was
+ * changed, so any number of save() calls results in a single write.
+ * File which exists but can't be read is never overwritten.
+ * Values are serialized using QDataStream, so any type supported by
+ * QVariant conversions can be stored.
+ */
+class BackendBinary final : public ConfigBackend<QString, QString, QVariant> {
+  using BackendType = ConfigBackend<QString, QString, QVariant>;
+
+public:
+  explicit BackendBinary(QString filename);
+  ~BackendBinary();
+
+  // false if file doesn't exist or can't be read
+  bool isLoaded() const noexcept { return _loaded; }
+  // true if file exists, but can't be read (corrupted, newer version, etc.)
+  bool isBroken() const noexcept { return _broken; }
+
+  // moves broken file to given location (replacing existing file),
+  // so it is kept for recovery and backend can be used to write settings
+  bool backupBroken(const QString& backup_filename);
+
+  void load(const QString&) override {}
+  void save(const QString&) override {}
+  void flush() override;
+
+  SettingsData allSettings() const override { return _settings; }
+  SettingsMap tagSettings(const QString& tag) const override;
+
+  void setValue(const QString& tag, const QString& k, const QVariant& v) override;
+  std::optional<QVariant> value(const QString& tag, const QString& k) const override;
+
+  // replaces everything with settings from other backend and saves them,
+  // intended to be used for one-time migration from other storage,
+  // does nothing if file is broken
+  void migrateFrom(const BackendType& other);
+
+  // human-readable representation, for debugging purposes only,
+  // values not representable in JSON are exported as type names
+  QJsonDocument toJson() const;
+
+private:
+  bool readFile();
+  bool writeFile() const;
+
+private:
+  QString _filename;
+  SettingsData _settings;
+  bool _loaded = false;
+  bool _broken = false;
+  bool _dirty = false;
+};
@@ -44,6 +44,16 @@ public:
     return all_settings;
   }
 
+  SettingsMap tagSettings(const QString& tag) const override
+  {
+    SettingsMap tag_settings;
+    GroupGuard _(*_settings, tag);
+    const auto keys = _settings->childKeys();
+    for (const auto& key : keys)
+      tag_settings[key] = _settings->value(key);
+    return tag_settings;
+  }
+
   void setValue(const QString& tag, const QString& k, const QVariant& v) override
   {
     GroupGuard _(*_settings, tag);
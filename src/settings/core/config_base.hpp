@@ -6,15 +6,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "settings.hpp"
 
+// key is created only once, on first access,
+// converted value is kept until storage changes
 #define CONFIG_OPTION(type, name, key, def_value) \
+  private:            \
+    mutable CachedOption<type> _cache_##name; \
   public:             \
-    void set##name(const type& val) { client().setValue(key, val); } \
-    type get##name() const { return client().value(key, def_value); }
+    static const OptionKey& name##Key() { static const OptionKey k(key); return k; } \
+    void set##name(const type& val) { setOption(name##Key(), val); } \
+    type get##name() const { return cachedOption(_cache_##name, name##Key(), [&]() -> type { return def_value; }); }
 
 
 template<typename Key, typename Value>
@@ -22,16 +31,81 @@ class ConfigBase {
   using ConfigClientType = ConfigClient<Key, Value>;
 
 public:
+  using ChangeListener = std::function<void(const Key&)>;
+
   explicit ConfigBase(std::unique_ptr<ConfigClientType> client) noexcept
     : _client(std::move(client))
   {}
 
-  inline void commit() { _client->commit(); }
-  inline void discard() { _client->discard(); }
+  void commit()
+  {
+    _client->commit();
+    _changed_keys.clear();
+  }
+
+  // reverted options are reported as changed too
+  void discard()
+  {
+    _client->discard();
+    auto changed_keys = std::exchange(_changed_keys, {});
+    for (const auto& k : changed_keys)
+      notify(k);
+  }
+
+  // listener is called after option value was set
+  std::size_t subscribe(ChangeListener listener)
+  {
+    _listeners.emplace_back(++_last_listener_id, std::move(listener));
+    return _last_listener_id;
+  }
+
+  void unsubscribe(std::size_t id)
+  {
+    std::erase_if(_listeners, [id](const auto& l) { return l.first == id; });
+  }
 
 protected:
+  using OptionKey = Key;
+
+  template<typename T>
+  struct CachedOption {
+    std::optional<T> value;
+    std::size_t revision = 0;
+  };
+
   inline ConfigClientType& client() const noexcept { return *_client; }
 
+  template<typename T, typename F>
+  const T& cachedOption(CachedOption<T>& c, const Key& k, F&& def) const
+  {
+    if (!c.value || c.revision != _client->revision()) {
+      c.value = _client->value(k, std::invoke(std::forward<F>(def)));
+      c.revision = _client->revision();
+    }
+    return *c.value;
+  }
+
+  template<typename T>
+  void setOption(const Key& k, const T& v)
+  {
+    _client->setValue(k, v);
+    if (std::ranges::find(_changed_keys, k) == _changed_keys.end())
+      _changed_keys.push_back(k);
+    notify(k);
+  }
+
+private:
+  void notify(const Key& k) const
+  {
+    // listener may unsubscribe itself
+    auto listeners = _listeners;
+    for (const auto& [id, listener] : listeners)
+      listener(k);
+  }
+
 private:
   std::unique_ptr<ConfigClientType> _client;
+  std::vector<Key> _changed_keys;
+  std::vector<std::pair<std::size_t, ChangeListener>> _listeners;
+  std::size_t _last_listener_id = 0;
 };
@@ -34,6 +34,10 @@ public:
   virtual void commit() = 0;
   virtual void discard() = 0;
 
+  // changes every time when any value may change,
+  // can be used to invalidate caches of converted values
+  virtual std::size_t revision() const noexcept = 0;
+
   template<typename T>
   void setValue(const Key& k, const T& v)
   {
@@ -62,11 +66,23 @@ public:
 
   virtual void load(const Tag& tag) = 0;
   virtual void save(const Tag& tag) = 0;
+  // called once after a batch of save() calls, backends which
+  // write everything at once should do the actual writing here
+  virtual void flush() {}
 
   using SettingsMap = std::unordered_map<Key, Value>;
   using SettingsData = std::unordered_map<Tag, SettingsMap>;
   virtual SettingsData allSettings() const = 0;
 
+  // used to fill the in-memory snapshot, called once per tag until invalidated
+  // default implementation is not efficient, backends should override it
+  virtual SettingsMap tagSettings(const Tag& tag) const
+  {
+    auto all_settings = allSettings();
+    auto iter = all_settings.find(tag);
+    return iter != all_settings.end() ? std::move(iter->second) : SettingsMap();
+  }
+
   virtual void setValue(const Tag& tag, const Key& k, const Value& v) = 0;
   virtual std::optional<Value> value(const Tag& tag, const Key& k) const = 0;
 };
@@ -94,9 +110,10 @@ class ConfigStorage {
     using ConfigStorageType = ConfigStorage<Tag, Key, Value>;
 
   public:
-    ConfigClientImpl(ConfigStorageType* storage, Tag&& tag) noexcept
+    ConfigClientImpl(ConfigStorageType* storage, Tag&& tag)
       : _storage(storage)
       , _tag(std::forward<Tag>(tag))
+      , _tag_revision(storage->tagRevision(_tag))
     {}
 
     ConfigClientImpl(const ConfigClientImpl&) = delete;
@@ -108,6 +125,12 @@ class ConfigStorage {
     inline void commit() override { _storage->commit(_tag); }
     inline void discard() override { _storage->discard(_tag); }
 
+    // no any lookup, so it is cheap enough to be checked on each access
+    inline std::size_t revision() const noexcept override
+    {
+      return _storage->generation() + *_tag_revision;
+    }
+
   protected:
     inline void setValue(const Key& k, Value&& v) override
     {
@@ -122,6 +145,7 @@ class ConfigStorage {
   private:
     ConfigStorageType* _storage;
     Tag _tag;
+    const std::size_t* _tag_revision;
   };
 
   using ConfigBackendType = ConfigBackend<Tag, Key, Value>;
@@ -156,6 +180,7 @@ public:
   {
     _current_cache.clear();
     _import_cache = std::move(data);
+    ++_generation;
   }
 
   void commitImported()
@@ -164,13 +189,16 @@ public:
       for (const auto& [key, value] : settings)
         _backend->setValue(tag, key, value);
       _backend->save(tag);
+      _snapshot.erase(tag);
     }
     _import_cache.clear();
+    ++_generation;
   }
 
   void discardImported() noexcept
   {
     _import_cache.clear();
+    ++_generation;
   }
 
   // function must be NON-const because non-const this is required
@@ -180,6 +208,14 @@ public:
   }
 
 protected:
+  // incremented on changes affecting all tags (import),
+  // per-tag revision is incremented on changes of that tag only,
+  // so clients can detect outdated cached values
+  std::size_t generation() const noexcept { return _generation; }
+
+  // returned pointer remains valid, map nodes are never removed
+  const std::size_t* tagRevision(const Tag& tag) { return &_revisions[tag]; }
+
   void commit(const Tag& tag)
   {
     // it's fine to create an empty container
@@ -191,18 +227,22 @@ protected:
       for (const auto& [k, v] : current)
         _backend->setValue(tag, k, v);
       _backend->save(tag);
+      _snapshot.erase(tag);
     }
+    // visible values remain the same, so revision is not changed
     current.clear();
   }
 
   void discard(const Tag& tag)
   {
     _current_cache.erase(tag);
+    ++_revisions[tag];
   }
 
   void setValue(const Tag& tag, const Key& key, Value&& value)
   {
     _current_cache[tag][key] = std::forward<Value>(value);
+    ++_revisions[tag];
   }
 
   std::optional<Value> value(const Tag& tag, const Key& key) const
@@ -213,11 +253,29 @@ protected:
     if (auto val = find_value(_import_cache, tag, key))
       return val;
 
-    _backend->load(tag);
-    return _backend->value(tag, key);
+    const auto& saved = snapshot(tag);
+    if (auto iter = saved.find(key); iter != saved.end())
+      return iter->second;
+
+    return std::nullopt;
   }
 
 private:
+  using SettingsMap = typename ConfigBackendType::SettingsMap;
+
+  // backend is queried only once per tag, all subsequent reads
+  // are served from memory until tag's data is written back
+  const SettingsMap& snapshot(const Tag& tag) const
+  {
+    auto iter = _snapshot.find(tag);
+    if (iter == _snapshot.end()) {
+      _backend->load(tag);
+      iter = _snapshot.emplace(tag, _backend->tagSettings(tag)).first;
+    }
+    return iter->second;
+  }
+
+
   // it should be free function, but as so as it is too specfic to this class
   // it was considered to make it private static member
   static std::optional<Value> find_value(const SettingsData& data, const Tag& tag, const Key& key)
@@ -238,4 +296,7 @@ private:
   std::shared_ptr<ConfigBackendType> _backend;
   SettingsData _current_cache;
   SettingsData _import_cache;
+  mutable SettingsData _snapshot;
+  std::unordered_map<Tag, std::size_t> _revisions;
+  std::size_t _generation = 0;
 };
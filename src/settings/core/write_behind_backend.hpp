@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "settings.hpp"
+
+// backend decorator that coalesces writes
+// written values are kept in memory until flush() is called,
+// schedule callback is called on each save request, so the owner
+// can decide when to flush (e.g. using some debounce timer)
+template<typename Tag, typename Key, typename Value>
+class WriteBehindBackend final : public ConfigBackend<Tag, Key, Value> {
+  using BackendType = ConfigBackend<Tag, Key, Value>;
+
+public:
+  using SettingsMap = typename BackendType::SettingsMap;
+  using SettingsData = typename BackendType::SettingsData;
+  using ScheduleCallback = std::function<void()>;
+
+  explicit WriteBehindBackend(std::shared_ptr<BackendType> backend,
+                              ScheduleCallback schedule = {})
+    : _backend(std::move(backend))
+    , _schedule(std::move(schedule))
+  {}
+
+  ~WriteBehindBackend() { flush(); }
+
+  void setScheduleCallback(ScheduleCallback schedule)
+  {
+    _schedule = std::move(schedule);
+  }
+
+  bool hasPendingWrites() const noexcept { return !_pending.empty(); }
+
+  // writes all pending values, each tag is saved only once
+  void flush() override
+  {
+    if (_pending.empty())
+      return;
+    for (const auto& [tag, settings] : _pending) {
+      for (const auto& [key, value] : settings)
+        _backend->setValue(tag, key, value);
+      _backend->save(tag);
+    }
+    _pending.clear();
+    _backend->flush();
+  }
+
+  void load(const Tag& tag) override { _backend->load(tag); }
+
+  void save(const Tag& tag) override
+  {
+    if (!_pending.contains(tag))
+      return;
+    if (_schedule)
+      _schedule();
+  }
+
+  SettingsData allSettings() const override
+  {
+    auto data = _backend->allSettings();
+    for (const auto& [tag, settings] : _pending)
+      merge_with_override(data[tag], settings);
+    return data;
+  }
+
+  SettingsMap tagSettings(const Tag& tag) const override
+  {
+    auto settings = _backend->tagSettings(tag);
+    if (auto iter = _pending.find(tag); iter != _pending.end())
+      merge_with_override(settings, iter->second);
+    return settings;
+  }
+
+  void setValue(const Tag& tag, const Key& k, const Value& v) override
+  {
+    _pending[tag][k] = v;
+  }
+
+  std::optional<Value> value(const Tag& tag, const Key& k) const override
+  {
+    if (auto titer = _pending.find(tag); titer != _pending.end())
+      if (auto viter = titer->second.find(k); viter != titer->second.end())
+        return viter->second;
+    return _backend->value(tag, k);
+  }
+
+private:
+  std::shared_ptr<BackendType> _backend;
+  ScheduleCallback _schedule;
+  SettingsData _pending;
+};
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "settings_export.hpp"
+
+#include <QDataStream>
+#include <QVariantHash>
+
+static const quint32 file_type_magic = 0x44435335;  // DCS5, BE
+static const quint16 serialization_format = 0x515A; // QZ, BE
+
+QByteArray SerializeSettings(const ExportedSettings& settings)
+{
+  QByteArray buffer;
+  QDataStream sout(&buffer, QIODevice::WriteOnly);
+  sout.setVersion(QDataStream::Qt_6_5);
+
+  QHash<QString, QVariantHash> qsettings;
+  for (const auto& [tag, ssec] : settings) {
+    qsettings[tag] = QVariantHash(ssec.begin(), ssec.end());
+  }
+  sout << qsettings;
+
+  QByteArray sdata = qCompress(buffer, 9);
+
+  QByteArray result;
+  QDataStream fout(&result, QIODevice::WriteOnly);
+  fout.setVersion(QDataStream::Qt_6_5);
+  fout << file_type_magic;
+  fout << serialization_format;
+  fout << qChecksum(sdata);
+  fout << static_cast<quint32>(sdata.size());
+  fout.writeRawData(sdata.data(), sdata.size());
+  return result;
+}
+
+std::optional<ExportedSettings> DeserializeSettings(const QByteArray& data)
+{
+  QDataStream fin(data);
+  fin.setVersion(QDataStream::Qt_6_5);
+
+  quint32 magic;
+  quint16 dsfmt;
+  quint16 dcsum;
+  quint32 dsize;
+
+  fin >> magic >> dsfmt >> dcsum >> dsize;
+
+  if (magic != file_type_magic) return std::nullopt;
+  if (dsfmt != serialization_format) return std::nullopt;
+
+  QByteArray sdata(dsize, Qt::Initialization{});
+  if (fin.readRawData(sdata.data(), sdata.size()) != dsize) return std::nullopt;
+  if (qChecksum(sdata) != dcsum) return std::nullopt;
+
+  QByteArray buffer = qUncompress(sdata);
+  QDataStream sin(&buffer, QIODevice::ReadOnly);
+  sin.setVersion(QDataStream::Qt_6_5);
+
+  QHash<QString, QVariantHash> qsettings;
+  sin >> qsettings;
+
+  ExportedSettings settings;
+  for (auto titer = qsettings.begin(); titer != qsettings.end(); ++titer) {
+    auto& tsettings = settings[titer.key()];
+    for (auto viter = titer.value().begin(); viter != titer.value().end(); ++viter) {
+      tsettings[viter.key()] = viter.value();
+    }
+  }
+  return settings;
+}
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "core/settings.hpp"
+
+#include <optional>
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+
+using ExportedSettings = ConfigStorage<QString, QString, QVariant>::SettingsData;
+
+// serializes settings into (compressed) export file content
+QByteArray SerializeSettings(const ExportedSettings& settings);
+
+// nullopt if data is not a valid export file content
+std::optional<ExportedSettings> DeserializeSettings(const QByteArray& data);
@@ -6,10 +6,14 @@
 
 #include "classic_skin.hpp"
 
+#include <algorithm>
+#include <utility>
+
 #include "datetime_formatter.hpp"
 #include "effects.hpp"
 #include "hasher.hpp"
 #include "linear_layout.hpp"
+#include "trace.hpp"
 
 namespace {
 
@@ -133,6 +137,13 @@ public:
     addItem(c);
   }
 
+  void addCharacters(std::span<const char32_t> chars) override
+  {
+    for (auto c : chars) ClassicLayoutBuilder::addCharacter(c);
+  }
+
+  void reserve(qsizetype count) override { _line->reserve(count); }
+
   void setSkinConfigHash(size_t hash) noexcept { _skin_cfg_hash = hash; }
 
   void setGlyphScaleFactor(qreal ks) noexcept { _ks = ks; }
@@ -154,20 +165,31 @@ public:
 
 protected:
   void addItem(char32_t c, bool visible = true)
+  {
+    if (auto r = createItem(c, visible))
+      addResource(std::move(r));
+  }
+
+  // returns nullptr if there is no glyph for given character
+  std::shared_ptr<Resource> createItem(char32_t c, bool visible = true) const
   {
     auto r = _factory->item(c);
     if (!r)
-      return;
+      return nullptr;
     if (visible)
-      r = buildItemStack(std::move(r));
-    else
-      r = std::make_shared<InvisibleResource>(r->rect(), r->advanceX(), r->advanceY());
+      return buildItemStack(std::move(r));
+    return std::make_shared<InvisibleResource>(r->rect(), r->advanceX(), r->advanceY());
+  }
+
+  void addResource(std::shared_ptr<Resource> r)
+  {
     auto item = std::make_shared<LayoutItem>(std::move(r));
-    item->setTransform(itemTransform(c).scale(_ks, _ks));
+    item->setTransform(QTransform(_item_transform).scale(_ks, _ks));
     _line->addItem(std::move(item));
   }
 
-  virtual QTransform itemTransform(char32_t c) const noexcept { return QTransform(); }
+  // transform applied to all subsequently added items
+  void setItemTransform(const QTransform& t) noexcept { _item_transform = t; }
 
 private:
   void addLine(std::shared_ptr<LinearLayout> line)
@@ -235,6 +257,7 @@ private:
   size_t _skin_cfg_hash = 0;
 
   qreal _ks = 1.0;
+  QTransform _item_transform;
 };
 
 
@@ -243,7 +266,6 @@ public:
   DateTimeLayoutBuilder(std::shared_ptr<ResourceFactory> factory,
                         const ClassicSkin& skin)
     : ClassicLayoutBuilder(std::move(factory), skin)
-    , _skin(skin)
   {}
 
   void addSeparator(char32_t c) override
@@ -267,15 +289,28 @@ public:
     addItem(c, separator_visible);
   }
 
-  void tokenStart(QStringView token) override
+  void addToken(int id, QStringView token, std::span<const char32_t> chars) override
+  {
+    Q_UNUSED(token);
+    // transforms are resolved by token ID, so only one lookup per token
+    if (id < std::ssize(_token_transforms))
+      setItemTransform(_token_transforms[id]);
+    // line breaks can't be cached, they affect the layout structure
+    if (id < std::ssize(_token_glyphs) && std::ranges::find(chars, U'\n') == chars.end())
+      addTokenGlyphs(_token_glyphs[id], chars);
+    else
+      addCharacters(chars);
+    setItemTransform(QTransform());
+  }
+
+  void setTokenTransforms(std::span<const QTransform> transforms) noexcept
   {
-    _current_token = token.toString();
+    _token_transforms = transforms;
   }
 
-  void tokenEnd(QStringView token) override
+  void setTokenGlyphsCache(std::span<TokenGlyphs> cache) noexcept
   {
-    Q_UNUSED(token)
-    _current_token.clear();
+    _token_glyphs = cache;
   }
 
   void setSupportsCustomSeparator(bool supports) noexcept
@@ -303,16 +338,22 @@ public:
     _separator_visible = visible;
   }
 
-protected:
-  QTransform itemTransform(char32_t c) const noexcept override
+private:
+  // glyphs are rebuilt only if token value has changed since the last time
+  void addTokenGlyphs(TokenGlyphs& cache, std::span<const char32_t> chars)
   {
-    Q_UNUSED(c);
-    return _skin.tokenTransform(_current_token);
+    if (!std::ranges::equal(cache.chars, chars)) {
+      cache.chars.assign(chars.begin(), chars.end());
+      cache.glyphs.clear();
+      for (auto c : chars)
+        if (auto r = createItem(c))
+          cache.glyphs.push_back(std::move(r));
+    }
+    for (const auto& r : cache.glyphs)
+      addResource(r);
   }
 
 private:
-  const ClassicSkin& _skin;
-
   bool _supports_custom_separator = false;
   bool _supports_separator_animation = false;
   bool _animate_separator = true;
@@ -321,13 +362,57 @@ private:
   quint32 _separator_idx = 0;
   QList<uint> _separators;
 
-  QString _current_token;
+  std::span<const QTransform> _token_transforms;
+  std::span<TokenGlyphs> _token_glyphs;
+};
+
+
+// records everything that affects the layout to detect unchanged frames
+class FrameRecorder final : public DateTimeStringBuilder {
+public:
+  explicit FrameRecorder(std::vector<char32_t>& frame) noexcept
+    : _frame(frame)
+  {
+    _frame.clear();
+  }
+
+  void addCharacter(char32_t c) override { _frame.push_back(c); }
+  void addSeparator(char32_t c) override { _frame.push_back(c); }
+
+  void addCharacters(std::span<const char32_t> chars) override
+  {
+    _frame.insert(_frame.end(), chars.begin(), chars.end());
+  }
+
+  void addToken(int id, QStringView token, std::span<const char32_t> chars) override
+  {
+    Q_UNUSED(token);
+    // token boundaries matter too (each token has its own transform),
+    // use values out of Unicode range to mark them
+    _frame.push_back(0x110000 + id);
+    addCharacters(chars);
+  }
+
+private:
+  std::vector<char32_t>& _frame;
 };
 
 } // namespace
 
 std::shared_ptr<Resource> ClassicSkin::process(const QDateTime& dt)
 {
+  TRACE_SPAN("ClassicSkin::process");
+  // formatting is cheap, so format the string first,
+  // and rebuild the layout only if something visible has changed
+  FrameRecorder recorder(_frame);
+  FormatDateTime(dt, _compiled_format, _locale, recorder);
+  if (_last_layout && _frame == _last_frame && _separator_visible == _last_separator_visible)
+    return _last_layout;
+  std::swap(_frame, _last_frame);
+  _last_separator_visible = _separator_visible;
+
+  _token_glyphs.resize(_compiled_format.tokensCount());
+
   DateTimeLayoutBuilder builder(_factory, *this);
   builder.setSupportsCustomSeparator(supportsCustomSeparator());
   builder.setSupportsSeparatorAnimation(supportsSeparatorAnimation());
@@ -336,13 +421,17 @@ std::shared_ptr<Resource> ClassicSkin::process(const QDateTime& dt)
   builder.setSeparatorVisible(_separator_visible);
   builder.setSkinConfigHash(_skin_cfg_hash);
   builder.setGlyphScaleFactor(_k_base_size);
-  FormatDateTime(dt, _format, builder);
-  return builder.getLayout();
+  builder.setTokenTransforms(_token_transforms);
+  builder.setTokenGlyphsCache(_token_glyphs);
+  FormatDateTime(dt, _compiled_format, _locale, builder);
+  _last_layout = builder.getLayout();
+  return _last_layout;
 }
 
 void ClassicSkin::setTokenTransform(QString token, QTransform transform)
 {
   _token_transform[std::move(token)] = std::move(transform);
+  updateTokenTransforms();
   handleConfigChange();
 }
 
@@ -351,9 +440,19 @@ QTransform ClassicSkin::tokenTransform(const QString& token) const noexcept
   return _token_transform.value(token, QTransform());
 }
 
+void ClassicSkin::updateTokenTransforms()
+{
+  _token_transforms.resize(_compiled_format.tokensCount());
+  for (qsizetype i = 0; i < _compiled_format.tokensCount(); i++)
+    _token_transforms[i] = tokenTransform(_compiled_format.tokenName(i));
+}
+
 void ClassicSkin::handleConfigChange()
 {
   ClassicSkinBase::handleConfigChange();
+  if (updateInProgress()) return;
+  _token_glyphs.clear();
+  _last_layout.reset();
   configurationChanged();
 }
 
@@ -390,8 +489,18 @@ void ClassicSkinBase::setLayoutConfig(QString layout_config)
   handleConfigChange();
 }
 
+void ClassicSkinBase::endUpdate()
+{
+  if (--_update_depth == 0 && std::exchange(_changed_during_update, false))
+    handleConfigChange();
+}
+
 void ClassicSkinBase::handleConfigChange()
 {
+  if (updateInProgress()) {
+    _changed_during_update = true;
+    return;
+  }
   updateConfigHash();
 }
 
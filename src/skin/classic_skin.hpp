@@ -9,10 +9,13 @@
 #include "skin.hpp"
 
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include <QBrush>
 #include <QString>
 
+#include "datetime_formatter.hpp"
 #include "resource_factory.hpp"
 
 class ClassicSkinBase {
@@ -99,15 +102,27 @@ public:
   void setLayoutConfig(QString layout_config);
   QString layoutConfig() const noexcept { return _layout_config; }
 
-  void setCachingEnabled(bool enable) noexcept { _caching_enabled = enable; }
-  inline void enableCaching() noexcept { setCachingEnabled(true); }
-  inline void disableCaching() noexcept { setCachingEnabled(false); }
+  void setCachingEnabled(bool enable)
+  {
+    _caching_enabled = enable;
+    handleConfigChange();
+  }
+  inline void enableCaching() { setCachingEnabled(true); }
+  inline void disableCaching() { setCachingEnabled(false); }
   bool cachingEnabled() const noexcept { return _caching_enabled; }
 
+  // config change is handled only once at the outermost endUpdate()
+  void beginUpdate() noexcept { ++_update_depth; }
+  void endUpdate();
+
+  MemoryUsage memoryUsage() const { return _factory->memoryUsage(); }
+
 protected:
   virtual void handleConfigChange();
   void updateConfigHash();
 
+  bool updateInProgress() const noexcept { return _update_depth > 0; }
+
 protected:  // TODO: make private
   std::shared_ptr<ResourceFactory> _factory;
   // public properties
@@ -128,6 +143,10 @@ protected:  // TODO: make private
   qreal _spacing = 0.0;
   qreal _k_base_size = 1.0;
   QString _layout_config;
+
+private:
+  int _update_depth = 0;
+  bool _changed_during_update = false;
 };
 
 
@@ -141,12 +160,23 @@ public:
 };
 
 
+// glyphs built for the last formatted value of some token
+struct TokenGlyphs {
+  std::vector<char32_t> chars;
+  std::vector<std::shared_ptr<Resource>> glyphs;
+};
+
+
 class ClassicSkin final : public ClassicSkinBase, public Skin {
 public:
   explicit ClassicSkin(std::shared_ptr<ResourceFactory> factory)
     : ClassicSkinBase(std::move(factory))
     , _format(QLatin1String("hh:mm a"))
-  {}
+    , _compiled_format(_format)
+  {
+    // characters used by almost any format, create them at load time
+    _factory->prewarm(std::u32string_view(U"0123456789: "));
+  }
 
   std::shared_ptr<Resource> process(const QDateTime& dt) override;
 
@@ -163,8 +193,29 @@ public:
     _separator_visible = !_separator_visible;
   }
 
+  void setLocale(const QLocale& locale) override
+  {
+    _locale = DateTimeLocale(locale);
+    handleConfigChange();
+  }
+
   void visit(SkinVisitor& visitor) override { visitor.visit(this); }
 
+  void beginUpdate() override
+  {
+    ClassicSkinBase::beginUpdate();
+    Skin::beginUpdate();
+  }
+
+  // handles accumulated config change, then notifies observers
+  void endUpdate() override
+  {
+    ClassicSkinBase::endUpdate();
+    Skin::endUpdate();
+  }
+
+  MemoryUsage memoryUsage() const override { return ClassicSkinBase::memoryUsage(); }
+
   void setSupportsCustomSeparator(bool supports) noexcept
   {
     _supports_custom_separator = supports;
@@ -203,6 +254,8 @@ public:
     if (format.isEmpty() || format == _format)
       return;
     _format = std::move(format);
+    _compiled_format = DateTimeFormat(_format);
+    updateTokenTransforms();
     handleConfigChange();
   }
 
@@ -214,6 +267,10 @@ public:
 protected:
   void handleConfigChange() override;
 
+private:
+  // resolves token transforms by token ID for the current format
+  void updateTokenTransforms();
+
 private:
   // public properties
   bool _supports_custom_separator = false;
@@ -222,6 +279,15 @@ private:
   bool _animate_separator = true;
   bool _separator_visible = true;
   QString _format;
+  DateTimeFormat _compiled_format;
+  DateTimeLocale _locale;
   QList<uint> _separators;
   QHash<QString, QTransform> _token_transform;
+  std::vector<QTransform> _token_transforms;
+  // memoization, must be dropped on any config change
+  std::vector<TokenGlyphs> _token_glyphs;   // indexed by token ID
+  std::vector<char32_t> _frame;
+  std::vector<char32_t> _last_frame;
+  bool _last_separator_visible = true;
+  std::shared_ptr<Resource> _last_layout;
 };
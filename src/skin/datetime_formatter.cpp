@@ -7,6 +7,7 @@
 #include "datetime_formatter.hpp"
 
 #include <QLocale>
+#include <QVarLengthArray>
 
 namespace {
 
@@ -28,40 +29,83 @@ char32_t escape_char(char32_t c) noexcept
   }
 }
 
-void add_characters(QStringView chars, DateTimeStringBuilder& builder)
+// formatted token characters, enough for any reasonable token
+using TokenBuffer = QVarLengthArray<char32_t, 32>;
+
+void add_characters(QStringView chars, TokenBuffer& buf)
 {
   const auto code_points = chars.toUcs4();
-  for (auto c : code_points) builder.addCharacter(c);
+  buf.append(code_points.data(), code_points.size());
 }
 
-void format_number(int n, int pad, DateTimeStringBuilder& str_builder)
+void add_characters(std::u32string_view chars, TokenBuffer& buf)
 {
-  add_characters(QString("%L1").arg(n, pad, 10, QChar('0')), str_builder);
+  buf.append(chars.data(), chars.size());
 }
 
-class TokenNotifier final {
-public:
-  TokenNotifier(DateTimeStringBuilder& builder, QString token)
-      : _builder(builder)
-      , _token(std::move(token))
-  {
-    _builder.tokenStart(_token);
-  }
+// only small numbers are formatted (< 1000), so group separators
+// are never required, negative numbers come only from invalid date/time
+// (e.g. -1 as hour), they are formatted as before, sign counts in padding
+void format_number(int n, int pad, char32_t zero, TokenBuffer& buf)
+{
+  const bool negative = n < 0;
+  unsigned int u = negative ? 0u - static_cast<unsigned int>(n) : n;
+  constexpr int digits_size = 16;
+  char32_t digits[digits_size];
+  int pos = digits_size;
+  do {
+    digits[--pos] = zero + u % 10;
+    u /= 10;
+  } while (u > 0 && pos > 0);
+  if (negative) --pad;
+  while (digits_size - pos < pad && pos > 0)
+    digits[--pos] = zero;
+  if (negative && pos > 0)
+    digits[--pos] = U'-';
+  buf.append(digits + pos, digits_size - pos);
+}
 
-  ~TokenNotifier()
-  {
-    _builder.tokenEnd(_token);
-  }
+std::u32string to_u32string(const QString& s)
+{
+  const auto code_points = s.toUcs4();
+  return {code_points.begin(), code_points.end()};
+}
 
-private:
-  DateTimeStringBuilder& _builder;
-  QString _token;
-};
+DateTimeLocale::TextCase am_pm_case(QStringView token) noexcept
+{
+  // mixed case means "as is", i.e. locale-specific case
+  if (token.size() == 2 && token[0].isUpper() != token[1].isUpper())
+    return DateTimeLocale::TextCase::AsIs;
+  return token[0].isUpper() ? DateTimeLocale::TextCase::Upper
+                            : DateTimeLocale::TextCase::Lower;
+}
 
 } // namespace
 
-void FormatDateTime(const QDateTime& dt, QStringView sfmt,
-                    DateTimeStringBuilder& str_builder)
+DateTimeLocale::DateTimeLocale(const QLocale& locale)
+    : _locale(locale)
+{
+  for (int i = 0; i < 2; i++) {
+    const auto type = i == 0 ? QLocale::ShortFormat : QLocale::LongFormat;
+    for (int m = 1; m <= 12; m++)
+      _months[i][m - 1] = to_u32string(locale.monthName(m, type));
+    for (int d = 1; d <= 7; d++)
+      _days[i][d - 1] = to_u32string(locale.dayName(d, type));
+  }
+
+  const std::array am_pm = {locale.amText(), locale.pmText()};
+  for (int i = 0; i < 2; i++) {
+    _am_pm[i][static_cast<int>(TextCase::AsIs)] = to_u32string(am_pm[i]);
+    _am_pm[i][static_cast<int>(TextCase::Lower)] = to_u32string(locale.toLower(am_pm[i]));
+    _am_pm[i][static_cast<int>(TextCase::Upper)] = to_u32string(locale.toUpper(am_pm[i]));
+  }
+
+  const auto zero_digit = locale.zeroDigit().toUcs4();
+  if (!zero_digit.isEmpty())
+    _zero_digit = zero_digit.front();
+}
+
+DateTimeFormat::DateTimeFormat(QStringView sfmt)
 {
   const auto fp = sfmt.toUcs4();
   const std::vector<char32_t> fmt(fp.begin(), fp.end());
@@ -74,7 +118,7 @@ void FormatDateTime(const QDateTime& dt, QStringView sfmt,
 
     if (escaped) {
       escaped = false;
-      str_builder.addCharacter(escape_char(c));
+      addCharacter(escape_char(c));
       continue;
     }
 
@@ -89,49 +133,184 @@ void FormatDateTime(const QDateTime& dt, QStringView sfmt,
     }
 
     if (quoted) {
-      str_builder.addCharacter(c);
+      addCharacter(c);
       continue;
     }
 
     int repeat = repeat_count(i, fmt);
 
     switch (c) {
-      case 'h': {
+      case 'h':
         repeat = qMin(repeat, 2);
-        TokenNotifier _(str_builder, QString(repeat, QChar(c)));
-        auto h = dt.time().hour();
-        if (h == 0) h = 12;
-        format_number(h > 12 ? h - 12 : h, repeat == 2 ? 2 : 0, str_builder);
+        addToken(TokenType::Hour12, QString(repeat, QChar(c)), repeat == 2 ? 2 : 0);
         break;
-      }
-      case 'J': {
+      case 'J':
         repeat = qMin(repeat, 1);
-        TokenNotifier _(str_builder, QString(repeat, QChar(c)));
-        format_number(dt.date().dayOfYear(), 0, str_builder);
+        addToken(TokenType::DayOfYear, QString(repeat, QChar(c)));
         break;
-      }
-      case 'W': {
+      case 'W':
         repeat = qMin(repeat, 2);
-        TokenNotifier _(str_builder, QString(repeat, QChar(c)));
-        format_number(dt.date().weekNumber(), repeat == 2 ? 2 : 0, str_builder);
+        addToken(TokenType::WeekNumber, QString(repeat, QChar(c)), repeat == 2 ? 2 : 0);
+        break;
+      case 'H':
+      case 'm':
+      case 's':
+        if (repeat <= 2) {
+          const auto type = c == 'H' ? TokenType::Hour24 :
+                            c == 'm' ? TokenType::Minute : TokenType::Second;
+          addToken(type, QString(repeat, QChar(c)), repeat == 2 ? 2 : 0);
+        } else {
+          addToken(TokenType::Locale, QString(repeat, QChar(c)));
+        }
+        break;
+      case 'd':
+      case 'M':
+        if (repeat <= 2) {
+          addToken(c == 'd' ? TokenType::Day : TokenType::Month,
+                   QString(repeat, QChar(c)), repeat == 2 ? 2 : 0);
+        } else if (repeat == 3 || repeat == 4) {
+          addToken(c == 'd' ? TokenType::DayName : TokenType::MonthName,
+                   QString(repeat, QChar(c)),
+                   repeat == 4 ? QLocale::LongFormat : QLocale::ShortFormat);
+        } else {
+          addToken(TokenType::Locale, QString(repeat, QChar(c)));
+        }
         break;
-      }
       case ':':
-        str_builder.addSeparator(c);
+        addSeparator(c);
         break;
       case 'a':
-      case 'A':
+      case 'A': {
         repeat = qMin(repeat, 1);
         if (i + 1 < fmt.size() && (fmt[i+1] == 'p' || fmt[i+1] == 'P'))
           repeat += 1;  // AP should be handled as 'A' (case insensitive)
-        [[fallthrough]];
-      default: {
-        const auto sfmt = QString::fromUcs4(&fmt[i], repeat);
-        TokenNotifier _(str_builder, sfmt);
-        add_characters(QLocale::system().toString(dt, sfmt), str_builder);
+        auto token = QString::fromUcs4(&fmt[i], repeat);
+        const auto text_case = am_pm_case(token);
+        addToken(TokenType::AmPm, std::move(token), static_cast<int>(text_case));
+        break;
       }
+      default:
+        addToken(TokenType::Locale, QString::fromUcs4(&fmt[i], repeat));
     }
 
     i += repeat - 1;
   }
 }
+
+void DateTimeFormat::addCharacter(char32_t c)
+{
+  // extend the last characters run if possible
+  if (!_ops.empty() && _ops.back().code == OpCode::Characters) {
+    _chars.push_back(c);
+    ++_ops.back().size;
+    ++_size_hint;
+    return;
+  }
+
+  _ops.push_back({OpCode::Characters, {}, 0, static_cast<int>(_chars.size()), 1});
+  _chars.push_back(c);
+  ++_size_hint;
+}
+
+void DateTimeFormat::addSeparator(char32_t c)
+{
+  _ops.push_back({OpCode::Separator, {}, 0, static_cast<int>(c), 0});
+  ++_size_hint;
+}
+
+void DateTimeFormat::addToken(TokenType type, QString name, int param)
+{
+  // most tokens produce as many characters as their length
+  _size_hint += name.size();
+  auto id = _tokens.indexOf(name);
+  if (id < 0) {
+    id = _tokens.size();
+    _tokens.append(std::move(name));
+  }
+  _ops.push_back({OpCode::Token, type, static_cast<quint8>(param), static_cast<int>(id), 0});
+}
+
+void FormatDateTime(const QDateTime& dt, const DateTimeFormat& fmt,
+                    const DateTimeLocale& locale,
+                    DateTimeStringBuilder& str_builder)
+{
+  using OpCode = DateTimeFormat::OpCode;
+  using TokenType = DateTimeFormat::TokenType;
+
+  const auto zero = locale.zeroDigit();
+  TokenBuffer buf;
+
+  str_builder.reserve(fmt._size_hint);
+
+  for (const auto& op : fmt._ops) {
+    switch (op.code) {
+      case OpCode::Characters:
+        str_builder.addCharacters(std::span(fmt._chars).subspan(op.arg, op.size));
+        break;
+
+      case OpCode::Separator:
+        str_builder.addSeparator(static_cast<char32_t>(op.arg));
+        break;
+
+      case OpCode::Token: {
+        const auto& token = fmt._tokens[op.arg];
+        buf.clear();
+        switch (op.token_type) {
+          case TokenType::Hour12: {
+            auto h = dt.time().hour();
+            if (h == 0) h = 12;
+            format_number(h > 12 ? h - 12 : h, op.param, zero, buf);
+            break;
+          }
+          case TokenType::Hour24:
+            format_number(dt.time().hour(), op.param, zero, buf);
+            break;
+          case TokenType::Minute:
+            format_number(dt.time().minute(), op.param, zero, buf);
+            break;
+          case TokenType::Second:
+            format_number(dt.time().second(), op.param, zero, buf);
+            break;
+          case TokenType::Day:
+            format_number(dt.date().day(), op.param, zero, buf);
+            break;
+          case TokenType::Month:
+            format_number(dt.date().month(), op.param, zero, buf);
+            break;
+          case TokenType::DayOfYear:
+            format_number(dt.date().dayOfYear(), op.param, zero, buf);
+            break;
+          case TokenType::WeekNumber:
+            format_number(dt.date().weekNumber(), op.param, zero, buf);
+            break;
+          case TokenType::DayName: {
+            const auto type = static_cast<QLocale::FormatType>(op.param);
+            add_characters(locale.dayName(dt.date().dayOfWeek(), type), buf);
+            break;
+          }
+          case TokenType::MonthName: {
+            const auto type = static_cast<QLocale::FormatType>(op.param);
+            add_characters(locale.monthName(dt.date().month(), type), buf);
+            break;
+          }
+          case TokenType::AmPm: {
+            const auto text_case = static_cast<DateTimeLocale::TextCase>(op.param);
+            add_characters(locale.amPmText(dt.time().hour() >= 12, text_case), buf);
+            break;
+          }
+          case TokenType::Locale:
+            add_characters(locale.locale().toString(dt, token), buf);
+            break;
+        }
+        str_builder.addToken(op.arg, token, std::span(buf.constData(), buf.size()));
+        break;
+      }
+    }
+  }
+}
+
+void FormatDateTime(const QDateTime& dt, QStringView fmt,
+                    DateTimeStringBuilder& str_builder)
+{
+  FormatDateTime(dt, DateTimeFormat(fmt), DateTimeLocale(), str_builder);
+}
@@ -6,7 +6,15 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <QDateTime>
+#include <QLocale>
+#include <QStringList>
 #include <QStringView>
 
 class DateTimeStringBuilder {
@@ -18,8 +26,131 @@ public:
 
   virtual void tokenStart(QStringView token) {}
   virtual void tokenEnd(QStringView token) {}
+
+  // batched interface, FormatDateTime() uses only it
+  // default implementation forwards everything to per-character interface
+
+  // hint about expected characters count, called once before anything else
+  virtual void reserve(qsizetype count) {}
+
+  virtual void addCharacters(std::span<const char32_t> chars)
+  {
+    for (auto c : chars) addCharacter(c);
+  }
+
+  // id is token ID from DateTimeFormat, it is the same for the same token
+  virtual void addToken(int id, QStringView token, std::span<const char32_t> chars)
+  {
+    Q_UNUSED(id);
+    tokenStart(token);
+    addCharacters(chars);
+    tokenEnd(token);
+  }
+};
+
+// snapshot of locale-specific data used during formatting
+// it is intended to be captured once and refreshed only on locale change
+class DateTimeLocale final {
+public:
+  enum class TextCase : quint8 { AsIs, Lower, Upper };
+
+  DateTimeLocale() : DateTimeLocale(QLocale::system()) {}
+  explicit DateTimeLocale(const QLocale& locale);
+
+  const QLocale& locale() const noexcept { return _locale; }
+
+  // month is in range [1, 12], only short and long formats are available
+  std::u32string_view monthName(int month, QLocale::FormatType type) const noexcept
+  {
+    return _months[type == QLocale::LongFormat][month - 1];
+  }
+
+  // day is in range [1, 7] (Monday is 1), only short and long formats are available
+  std::u32string_view dayName(int day, QLocale::FormatType type) const noexcept
+  {
+    return _days[type == QLocale::LongFormat][day - 1];
+  }
+
+  std::u32string_view amPmText(bool pm, TextCase tc) const noexcept
+  {
+    return _am_pm[pm][static_cast<int>(tc)];
+  }
+
+  char32_t zeroDigit() const noexcept { return _zero_digit; }
+
+private:
+  QLocale _locale;
+  std::array<std::array<std::u32string, 12>, 2> _months;
+  std::array<std::array<std::u32string, 7>, 2> _days;
+  std::array<std::array<std::u32string, 3>, 2> _am_pm;
+  char32_t _zero_digit = '0';
 };
 
+// format string compiled into a sequence of simple operations
+// it is intended to be created once and used for many FormatDateTime() calls
 // in format string only ':' is considered as separator
+class DateTimeFormat final {
+public:
+  DateTimeFormat() = default;
+  explicit DateTimeFormat(QStringView fmt);
+
+  bool isEmpty() const noexcept { return _ops.empty(); }
+
+  // each distinct token has its own ID in range [0, tokensCount())
+  qsizetype tokensCount() const noexcept { return _tokens.size(); }
+  const QString& tokenName(int id) const noexcept { return _tokens[id]; }
+
+private:
+  enum class OpCode : quint8 {
+    Characters,   // literal characters run
+    Separator,    // single separator character
+    Token,        // formatted date/time value
+  };
+
+  enum class TokenType : quint8 {
+    Hour12,       // h, hh
+    Hour24,       // H, HH
+    Minute,       // m, mm
+    Second,       // s, ss
+    Day,          // d, dd
+    Month,        // M, MM
+    DayOfYear,    // J
+    WeekNumber,   // W, WW
+    DayName,      // ddd, dddd
+    MonthName,    // MMM, MMMM
+    AmPm,         // a, A, ap, AP, aP, Ap
+    Locale,       // anything else, formatted by QLocale
+  };
+
+  struct Op {
+    OpCode code;
+    TokenType token_type;   // tokens only
+    quint8 param;           // tokens only, zero-padding width for numbers,
+                            // name format or text case for text
+    int arg;                // token ID, separator or characters run offset
+    int size;               // characters run only, characters count
+  };
+
+  void addCharacter(char32_t c);
+  void addSeparator(char32_t c);
+  void addToken(TokenType type, QString name, int param = 0);
+
+  friend void FormatDateTime(const QDateTime& dt, const DateTimeFormat& fmt,
+                             const DateTimeLocale& locale,
+                             DateTimeStringBuilder& str_builder);
+
+private:
+  std::vector<Op> _ops;
+  std::vector<char32_t> _chars;   // characters runs pool
+  QStringList _tokens;
+  qsizetype _size_hint = 0;       // expected output characters count
+};
+
+void FormatDateTime(const QDateTime& dt, const DateTimeFormat& fmt,
+                    const DateTimeLocale& locale,
+                    DateTimeStringBuilder& str_builder);
+
+// just a shortcut, format string is compiled and
+// system locale data is captured on each call
 void FormatDateTime(const QDateTime& dt, QStringView fmt,
                     DateTimeStringBuilder& str_builder);
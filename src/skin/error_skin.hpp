@@ -54,6 +54,8 @@ public:
   void setSeparatorAnimationEnabled([[maybe_unused]] bool enabled) override {}
   void animateSeparator() override { _msg->setVisible(!_msg->isVisible()); }
 
+  void setLocale([[maybe_unused]] const QLocale& locale) override {}
+
   void visit(SkinVisitor& visitor) override { visitor.visit(this); }
 
 private:
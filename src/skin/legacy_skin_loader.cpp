@@ -15,6 +15,7 @@
 #include <QSettings>
 
 #include "image_resource.hpp"
+#include "shared_assets.hpp"
 
 namespace {
 
@@ -140,24 +141,6 @@ GeometryMap read_geometry_map(const QDir& skin_dir)
   return geometry;
 }
 
-std::shared_ptr<ImageResource> createResource(const QString& path)
-{
-  QFileInfo fi(path);
-
-  if (!fi.exists())
-    return nullptr;
-
-  QString ext = fi.suffix().toLower();
-
-  if (ext == "svg")
-    return std::make_shared<SvgImageResource>(path);
-
-  if (ext == "png")
-    return std::make_shared<RasterImageResource>(path);
-
-  return nullptr;
-}
-
 void updateGeometry(ImageResource& item, const GlyphGeometryRaw& gargs)
 {
   const auto& r = item.rect();
@@ -172,11 +155,11 @@ void updateGeometry(ImageResource& item, const GlyphGeometryRaw& gargs)
 
 } // namespace
 
-ImageResourceFactory::ImageResourceFactory(const SkinFilesMap& files)
+ImageResourceFactory::ImageResourceFactory(const SkinFilesMap& files, ImageSizeMap* sizes)
 {
   for (auto iter = files.begin(); iter != files.end(); ++iter) {
     const auto& [file, gargs] = iter.value();
-    auto resource = createResource(file);
+    auto resource = CreateImageResource(file, sizes);
     if (resource) {
       updateGeometry(*resource, gargs);
       _min_y = std::min(_min_y, resource->rect().top());
@@ -200,6 +183,14 @@ std::shared_ptr<Resource> ImageResourceFactory::create(char32_t c) const
   return iter != _resources.end() ? iter.value() : nullptr;
 }
 
+MemoryUsage ImageResourceFactory::memoryUsage() const
+{
+  MemoryUsage usage;
+  for (const auto& r : _resources)
+    if (r) usage += r->memoryUsage();
+  return usage;
+}
+
 
 void LegacySkinLoader::init(const QString& skin_root)
 {
@@ -208,6 +199,7 @@ void LegacySkinLoader::init(const QString& skin_root)
     return;
 
   QDir skin_dir(finfo.absoluteFilePath());
+  _skin_dir = skin_dir;
 
   setTitle(finfo.fileName());
 
@@ -217,6 +209,20 @@ void LegacySkinLoader::init(const QString& skin_root)
   setValid(!title().isEmpty() && _files.size() >= required_files.size());
 }
 
+std::unique_ptr<ClassicSkin> LegacySkinLoader::skin() const
+{
+  if (!valid())
+    return nullptr;
+
+  // glyphs are shared between all instances of the same skin
+  auto factory = SharedImageResourceFactory(SkinAssetsKey(_skin_dir), _files);
+  bool supports_separator_animation = factory->supportsSeparatorAnimation();
+  auto skin = std::make_unique<ClassicSkin>(std::move(factory));
+  skin->setSupportsGlyphBaseHeight(true);
+  skin->setSupportsSeparatorAnimation(supports_separator_animation);
+  return skin;
+}
+
 void LegacySkinLoader::loadMeta(const QDir& skin_dir)
 {
   if (!skin_dir.exists(skin_ini))
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "classic_skin_loader.hpp"
+#include "image_resource.hpp"
 #include "resource_factory.hpp"
 
 #include <optional>
@@ -28,13 +29,17 @@ using SkinFilesMap = QHash<QChar, SkinFileInfo>;
 
 class ImageResourceFactory final : public ResourceFactory {
 public:
-  explicit ImageResourceFactory(const SkinFilesMap& files);
+  // see CreateImageResource() for sizes map usage
+  explicit ImageResourceFactory(const SkinFilesMap& files, ImageSizeMap* sizes = nullptr);
 
   bool supportsSeparatorAnimation() const noexcept { return _has_2_seps; }
 
   qreal ascent() const noexcept override { return -_min_y; }
   qreal descent() const noexcept override { return _max_y; }
 
+  // all resources are created in advance, so all of them are counted
+  MemoryUsage memoryUsage() const override;
+
 protected:
   std::shared_ptr<Resource> create(char32_t ch) const override;
 
@@ -53,18 +58,7 @@ public:
     init(path);
   }
 
-  std::unique_ptr<ClassicSkin> skin() const override
-  {
-    if (!valid())
-      return nullptr;
-
-    auto factory = std::make_unique<ImageResourceFactory>(_files);
-    bool supports_separator_animation = factory->supportsSeparatorAnimation();
-    auto skin = std::make_unique<ClassicSkin>(std::move(factory));
-    skin->setSupportsGlyphBaseHeight(true);
-    skin->setSupportsSeparatorAnimation(supports_separator_animation);
-    return skin;
-  }
+  std::unique_ptr<ClassicSkin> skin() const override;
 
 private:
   void init(const QString& skin_root);
@@ -73,5 +67,6 @@ private:
   void loadFiles(const QDir& skin_dir);
 
 private:
+  QDir _skin_dir;
   SkinFilesMap _files;
 };
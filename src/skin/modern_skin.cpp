@@ -8,6 +8,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QFont>
 #include <QFontDatabase>
 #include <QJsonDocument>
@@ -21,26 +22,13 @@
 #include "legacy_skin_loader.hpp"
 #include "layout.hpp"
 #include "linear_layout.hpp"
+#include "shared_assets.hpp"
+#include "shared_registry.hpp"
+#include "skin_cache.hpp"
+#include "trace.hpp"
 
 namespace {
 
-std::unique_ptr<Resource> createResource(const QString& filename)
-{
-  QFileInfo fi(filename);
-
-  if (!fi.exists())
-    return nullptr;
-
-  auto ext = fi.suffix().toLower();
-  if (ext == "png")
-    return std::make_unique<RasterImageResource>(filename);
-  if (ext == "svg")
-    return std::make_unique<SvgImageResource>(filename);
-
-  return nullptr;
-}
-
-
 // helper RAII object to chage current path
 class PWDChanger final {
 public:
@@ -81,8 +69,9 @@ public:
 
   void process(const QDateTime& dt)
   {
-    _res->process(dt);
-    updateGeometry();
+    // skins return the same resource if nothing has changed
+    if (_res->process(dt))
+      updateGeometry();
   }
 
   std::shared_ptr<Skin> skin() const noexcept { return _res->skin(); }
@@ -102,7 +91,15 @@ private:
 
     size_t cacheKey() const override { return _res->cacheKey(); }
 
-    void process(const QDateTime& dt) { _res = _skin->process(dt); }
+    // returns true if resource has changed
+    bool process(const QDateTime& dt)
+    {
+      auto res = _skin->process(dt);
+      if (res == _res)
+        return false;
+      _res = std::move(res);
+      return true;
+    }
 
     std::shared_ptr<Skin> skin() const noexcept { return _skin; }
 
@@ -168,6 +165,33 @@ protected:
   }
 };
 
+// assets shared between all instances of the same skin
+struct ModernSkinAssets {
+  ~ModernSkinAssets()
+  {
+    std::ranges::for_each(std::as_const(fonts), &QFontDatabase::removeApplicationFont);
+  }
+
+  // custom fonts (IDs, for internal use only)
+  QSet<int> fonts;
+  // total size of loaded custom fonts files
+  std::size_t fonts_size = 0;
+  // standalone images
+  QHash<QString, std::shared_ptr<Resource>> images;
+  // shared effects
+  QHash<QString, std::shared_ptr<Effect>> effects;
+  // parsed skin description (skin.json)
+  QJsonObject config;
+  // default images sizes, filled during parsing if not cached
+  ImageSizeMap image_sizes;
+};
+
+SharedRegistry<QString, ModernSkinAssets>& sharedModernSkinAssets()
+{
+  static SharedRegistry<QString, ModernSkinAssets> registry;
+  return registry;
+}
+
 // serialization
 QFont parseFont(const QJsonObject& js)
 {
@@ -265,7 +289,7 @@ Qt::Alignment parseAlignment(const QJsonObject& js)
 
 std::unique_ptr<ClassicSkin> parseFontSkin(const QJsonObject& js)
 {
-  auto provider = std::make_unique<FontResourceFactory>(parseFont(js));
+  auto provider = SharedFontResourceFactory(parseFont(js));
   auto skin = std::make_unique<ClassicSkin>(std::move(provider));
   skin->setSupportsGlyphBaseHeight(false);
   skin->setSupportsCustomSeparator(true);
@@ -498,15 +522,10 @@ std::shared_ptr<Effect> parseEffect(const QJsonObject& js)
 
 class ModernSkin::Impl {
 public:
-  explicit Impl(const QDir& skin_root)
+  Impl(const QDir& skin_root, const SkinCache* cache)
   {
     _layout = std::make_shared<ModernLayout>();
-    init(skin_root);
-  }
-
-  ~Impl()
-  {
-    std::ranges::for_each(std::as_const(_fonts), &QFontDatabase::removeApplicationFont);
+    init(skin_root, cache);
   }
 
   std::shared_ptr<Resource> process(const QDateTime& dt)
@@ -534,25 +553,86 @@ public:
       item->setVisible(!item->isVisible());
   }
 
+  void setLocale(const QLocale& locale)
+  {
+    for (const auto& item : std::as_const(_items))
+      item->skin()->setLocale(locale);
+  }
+
+  MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    if (_assets) {
+      usage.fonts += _assets->fonts_size;
+      for (const auto& r : std::as_const(_assets->images))
+        if (r) usage += r->memoryUsage();
+    }
+    for (const auto& item : std::as_const(_items))
+      usage += item->skin()->memoryUsage();
+    return usage;
+  }
+
 private:
+  // skin description is taken from the cache if possible, cache key is
+  // returned only if description has been parsed and should be cached
+  std::shared_ptr<ModernSkinAssets> loadAssets(const SkinCache* cache, QByteArray& cache_key)
+  {
+    auto assets = std::make_shared<ModernSkinAssets>();
+
+    QByteArray key;
+    std::optional<CompiledSkin> compiled;
+    if (cache) {
+      key = SkinStateHash(_root);
+      compiled = cache->load(key, _root);
+    }
+
+    if (compiled) {
+      assets->config = std::move(compiled->config);
+      assets->image_sizes = std::move(compiled->image_sizes);
+    } else {
+      QFile skin_cfg(_root.absoluteFilePath("skin.json"));
+      if (!skin_cfg.open(QIODevice::ReadOnly)) return assets;
+      assets->config = QJsonDocument::fromJson(skin_cfg.readAll()).object();
+      cache_key = std::move(key);
+    }
+
+    const auto& js_obj = assets->config;
+
+    if (const auto v = js_obj["fonts"]; v.isArray())
+      loadCustomFonts(v.toArray(), *assets);
+
+    if (const auto v = js_obj["resources"]; v.isObject()) {
+      const auto js = v.toObject();
+      for (auto iter = js.begin(); iter != js.end(); ++iter)
+        if (iter.value().isString())
+          assets->images[iter.key()] = CreateImageResource(_root.absoluteFilePath(iter->toString()),
+                                                           &assets->image_sizes);
+    }
+
+    if (const auto v = js_obj["effects"]; v.isObject())
+      assets->effects = parseEffects(v.toObject());
+
+    return assets;
+  }
+
+  // standalone images are part of assets, only image skins are parsed here
   void parseResources(const QJsonObject& js)
   {
-    for (auto iter = js.begin(); iter != js.end(); ++iter) {
-      if (iter.value().isString())
-        _images[iter.key()] = createResource(_root.absoluteFilePath(iter->toString()));
+    for (auto iter = js.begin(); iter != js.end(); ++iter)
       if (iter.value().isObject())
         _skins[iter.key()] = parseSkinResources(iter->toObject());
-    }
   }
 
-  void parseEffects(const QJsonObject& js)
+  static QHash<QString, std::shared_ptr<Effect>> parseEffects(const QJsonObject& js)
   {
+    QHash<QString, std::shared_ptr<Effect>> effects;
     for (auto iter = js.begin(); iter != js.end(); ++iter) {
       if (!iter.value().isObject())
         continue;
       if (auto effect = parseEffect(iter->toObject()))
-        _effects[iter.key()] = std::move(effect);
+        effects[iter.key()] = std::move(effect);
     }
+    return effects;
   }
 
   void parseLayout(const QJsonArray& jsa)
@@ -623,8 +703,8 @@ private:
   std::shared_ptr<LayoutItem> parseStaticItem(const QJsonObject& js) const
   {
     if (const auto v = js["resource"]; v.isString()) {
-      auto res = _images.find(v.toString());
-      if (res == _images.end() || !*res) return nullptr;
+      auto res = _assets->images.find(v.toString());
+      if (res == _assets->images.end() || !*res) return nullptr;
       return std::make_shared<LayoutItem>(*res);
     }
 
@@ -633,11 +713,15 @@ private:
       if (const auto v = js["font"]; v.isObject())
         font = parseFont(v.toObject());
 
-      auto factory = std::make_unique<FontResourceFactory>(font);
+      auto factory = SharedFontResourceFactory(font);
       auto skin = std::make_unique<StaticText>(std::move(factory));
-      skin->setSupportsGlyphBaseHeight(false);
-      skin->setIgnoreAdvanceY(true);
-      parseClassicSkinBaseParams(js, *skin);
+      {
+        // config must be applied before item creation
+        SkinUpdateGuard _(*skin);
+        skin->setSupportsGlyphBaseHeight(false);
+        skin->setIgnoreAdvanceY(true);
+        parseClassicSkinBaseParams(js, *skin);
+      }
       return std::make_shared<StaticTextItem>(std::move(skin), v.toString());
     }
 
@@ -655,7 +739,10 @@ private:
 
     if (!skin) return nullptr;
 
-    parseClassicSkinParams(js, *skin);
+    {
+      SkinUpdateGuard _(*skin);
+      parseClassicSkinParams(js, *skin);
+    }
 
     return std::make_shared<SkinItem>(std::move(skin), QDateTime::currentDateTime());
   }
@@ -665,7 +752,7 @@ private:
     auto s_iter = _skins.find(name);
     if (s_iter == _skins.end() || s_iter.value().isEmpty())
       return nullptr;
-    auto factory = std::make_unique<ImageResourceFactory>(*s_iter);
+    auto factory = SharedImageResourceFactory(_assets_key + u'/' + name, *s_iter, &_assets->image_sizes);
     bool supports_separator_animation = factory->supportsSeparatorAnimation();
     auto skin = std::make_unique<ClassicSkin>(std::move(factory));
     skin->setSupportsGlyphBaseHeight(true);
@@ -769,7 +856,7 @@ private:
       std::shared_ptr<Effect> effect;
 
       if (v.isString())
-        effect = _effects.value(v.toString());
+        effect = _assets->effects.value(v.toString());
 
       if (v.isObject())
         effect = parseEffect(v.toObject());
@@ -793,16 +880,20 @@ private:
       parseItemsEffects(v.toArray(), item);
   }
 
-  void loadCustomFonts(const QJsonArray& jsa)
+  void loadCustomFonts(const QJsonArray& jsa, ModernSkinAssets& assets) const
   {
     for (const auto& v : jsa) {
       if (!v.isString()) continue;
       auto font_path = _root.absoluteFilePath(v.toString());
-      _fonts.insert(QFontDatabase::addApplicationFont(font_path));
+      auto font_id = QFontDatabase::addApplicationFont(font_path);
+      // font database keeps the whole file in memory
+      if (font_id != -1)
+        assets.fonts_size += QFileInfo(font_path).size();
+      assets.fonts.insert(font_id);
     }
   }
 
-  void init(const QDir& skin_root)
+  void init(const QDir& skin_root, const SkinCache* cache)
   {
     _root = skin_root;
 
@@ -813,24 +904,27 @@ private:
     // current working directory will be restored at the end
     PWDChanger _(skin_root.absolutePath());
 
-    QFile skin_cfg(skin_root.absoluteFilePath("skin.json"));
-    if (!skin_cfg.open(QIODevice::ReadOnly)) return;
+    // skin description, fonts, images and effects are loaded (or taken
+    // from the cache) only if no other instance of this skin exists,
+    // assets key is based only on file system metadata, so it is cheap
+    QByteArray cache_key;
+    _assets_key = SkinAssetsKey(skin_root);
+    _assets = sharedModernSkinAssets().get(_assets_key, [&]() { return loadAssets(cache, cache_key); });
+
+    const auto& js_obj = _assets->config;
 
-    auto js_obj = QJsonDocument::fromJson(skin_cfg.readAll()).object();
     if (const auto v = js_obj["name"]; v.isString())
       _name = v.toString();
 
-    if (const auto v = js_obj["fonts"]; v.isArray())
-      loadCustomFonts(v.toArray());
-
     if (const auto v = js_obj["resources"]; v.isObject())
       parseResources(v.toObject());
 
-    if (const auto v = js_obj["effects"]; v.isObject())
-      parseEffects(v.toObject());
-
     if (const auto v = js_obj["layout"]; v.isArray())
       parseLayout(v.toArray());
+
+    // all images are known at this point
+    if (cache && !cache_key.isEmpty())
+      cache->store(cache_key, skin_root, {js_obj, _assets->image_sizes});
   }
 
 private:
@@ -841,23 +935,21 @@ private:
   QDir _root;
   QString _name;
   // resources
-  QHash<QString, std::shared_ptr<Resource>> _images;
+  QString _assets_key;
+  std::shared_ptr<ModernSkinAssets> _assets;
   QHash<QString, SkinFilesMap> _skins;
-  // shared effects
-  QHash<QString, std::shared_ptr<Effect>> _effects;
-  // custom fonts (IDs, for internal use only)
-  QSet<int> _fonts;
 };
 
 
-ModernSkin::ModernSkin(const QDir& skin_root)
-  : _impl(std::make_unique<Impl>(skin_root))
+ModernSkin::ModernSkin(const QDir& skin_root, const SkinCache* cache)
+  : _impl(std::make_unique<Impl>(skin_root, cache))
 {}
 
 ModernSkin::~ModernSkin() = default;
 
 std::shared_ptr<Resource> ModernSkin::process(const QDateTime& dt)
 {
+  TRACE_SPAN("ModernSkin::process");
   return _impl->process(dt);
 }
 
@@ -870,3 +962,13 @@ void ModernSkin::animateSeparator()
 {
   _impl->animateSeparator();
 }
+
+void ModernSkin::setLocale(const QLocale& locale)
+{
+  _impl->setLocale(locale);
+}
+
+MemoryUsage ModernSkin::memoryUsage() const
+{
+  return _impl->memoryUsage();
+}
@@ -10,9 +10,12 @@
 
 #include <QDir>
 
+class SkinCache;
+
 class ModernSkin final : public Skin {
 public:
-  explicit ModernSkin(const QDir& skin_root);
+  // cache is optional, it is used only during construction
+  explicit ModernSkin(const QDir& skin_root, const SkinCache* cache = nullptr);
   ~ModernSkin();
 
   std::shared_ptr<Resource> process(const QDateTime& dt) override;
@@ -20,8 +23,12 @@ public:
   void setSeparatorAnimationEnabled(bool enabled) override;
   void animateSeparator() override;
 
+  void setLocale(const QLocale& locale) override;
+
   void visit(SkinVisitor& visitor) override { visitor.visit(this); }
 
+  MemoryUsage memoryUsage() const override;
+
 private:
   class Impl;
   std::unique_ptr<Impl> _impl;
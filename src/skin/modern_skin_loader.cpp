@@ -33,8 +33,8 @@ ModernSkinLoader::ModernSkinLoader(const QString& path)
   _valid = !_title.isEmpty();
 }
 
-std::unique_ptr<ModernSkin> ModernSkinLoader::skin() const
+std::unique_ptr<ModernSkin> ModernSkinLoader::skin(const SkinCache* cache) const
 {
   if (!_valid) return nullptr;
-  return std::make_unique<ModernSkin>(QDir(_path));
+  return std::make_unique<ModernSkin>(QDir(_path), cache);
 }
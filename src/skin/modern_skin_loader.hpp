@@ -16,7 +16,7 @@ public:
 
   QString title() const noexcept { return _title; }
 
-  std::unique_ptr<ModernSkin> skin() const;
+  std::unique_ptr<ModernSkin> skin(const SkinCache* cache = nullptr) const;
 
 private:
   QString _path;
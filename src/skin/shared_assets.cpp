@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "shared_assets.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QFileInfo>
+
+#include "shared_registry.hpp"
+
+QByteArray SkinStateHash(const QDir& skin_root)
+{
+  QStringList files;
+  QDirIterator iter(skin_root.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+  while (iter.hasNext())
+    files.append(skin_root.relativeFilePath(iter.next()));
+  // iteration order is not guaranteed
+  files.sort();
+
+  // no need to read files content, just to detect skin changes
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for (const auto& file : std::as_const(files)) {
+    QFileInfo fi(skin_root.absoluteFilePath(file));
+    hash.addData(file.toUtf8());
+    hash.addData(QByteArray::number(fi.size()));
+    hash.addData(QByteArray::number(fi.lastModified().toMSecsSinceEpoch()));
+  }
+  return hash.result().toHex();
+}
+
+QString SkinAssetsKey(const QDir& skin_root)
+{
+  return skin_root.absolutePath() + u':' + QString::fromLatin1(SkinStateHash(skin_root));
+}
+
+std::shared_ptr<FontResourceFactory> SharedFontResourceFactory(const QFont& font)
+{
+  static SharedRegistry<QString, FontResourceFactory> registry;
+  return registry.get(font.key(), [&]() { return std::make_shared<FontResourceFactory>(font); });
+}
+
+std::shared_ptr<ImageResourceFactory> SharedImageResourceFactory(const QString& key,
+                                                                 const SkinFilesMap& files,
+                                                                 ImageSizeMap* sizes)
+{
+  static SharedRegistry<QString, ImageResourceFactory> registry;
+  return registry.get(key, [&]() { return std::make_shared<ImageResourceFactory>(files, sizes); });
+}
@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QDir>
+#include <QFont>
+
+#include "font_resource.hpp"
+#include "legacy_skin_loader.hpp"
+
+// immutable skin assets (resource factories, images, fonts) are shared
+// between all skin instances created from the same source, assets are
+// released when the last skin using them is destroyed
+// must be used only from GUI thread
+
+// identifies skin content state (files list relative to skin root, their
+// sizes and modification times), doesn't depend on skin location,
+// files content is not read, so it is cheap enough to call on every load
+QByteArray SkinStateHash(const QDir& skin_root);
+
+// identifies skin location and content state, see SkinStateHash()
+QString SkinAssetsKey(const QDir& skin_root);
+
+std::shared_ptr<FontResourceFactory> SharedFontResourceFactory(const QFont& font);
+
+// key should be based on SkinAssetsKey(), see ImageResourceFactory for other args
+std::shared_ptr<ImageResourceFactory> SharedImageResourceFactory(const QString& key,
+                                                                 const SkinFilesMap& files,
+                                                                 ImageSizeMap* sizes = nullptr);
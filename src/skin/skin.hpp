@@ -7,8 +7,10 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include <QDateTime>
+#include <QLocale>
 
 #include "resource.hpp"
 #include "observable.hpp"
@@ -33,10 +35,52 @@ public:
 
   virtual void animateSeparator() = 0;
 
+  // locale used for date/time formatting, system locale by default
+  virtual void setLocale(const QLocale& locale) = 0;
+
   virtual void visit(SkinVisitor& visitor) = 0;
 
+  // memory held by skin (resources, fonts, etc.), shared
+  // assets are counted in each skin that uses them
+  virtual MemoryUsage memoryUsage() const { return {}; }
+
+  // notifications are deferred until the outermost endUpdate(),
+  // so a lot of changes cause only one notification
+  virtual void beginUpdate() { ++_update_depth; }
+  virtual void endUpdate()
+  {
+    if (--_update_depth == 0 && std::exchange(_changed_during_update, false))
+      configurationChanged();
+  }
+
 protected:
   // implementations should call this to notify about its configuration change
   // it also should be called when geometry is changed too
-  void configurationChanged() const { notify(&SkinObserver::onConfigurationChanged); }
+  void configurationChanged() const
+  {
+    if (_update_depth > 0) {
+      _changed_during_update = true;
+      return;
+    }
+    notify(&SkinObserver::onConfigurationChanged);
+  }
+
+private:
+  int _update_depth = 0;
+  mutable bool _changed_during_update = false;
+};
+
+// RAII helper for beginUpdate()/endUpdate() pair,
+// works with any skin-like type (e.g. ClassicSkinBase)
+template<class SkinType>
+class SkinUpdateGuard final {
+public:
+  explicit SkinUpdateGuard(SkinType& skin) : _skin(skin) { _skin.beginUpdate(); }
+  ~SkinUpdateGuard() { _skin.endUpdate(); }
+
+  SkinUpdateGuard(const SkinUpdateGuard&) = delete;
+  SkinUpdateGuard& operator=(const SkinUpdateGuard&) = delete;
+
+private:
+  SkinType& _skin;
 };
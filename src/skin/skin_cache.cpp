@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "skin_cache.hpp"
+
+#include <QCborValue>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+namespace {
+
+using namespace Qt::Literals::StringLiterals;
+
+constexpr quint32 cache_magic = 0x44435343;  // "DCSC"
+// must be incremented on any change in entry format
+// or in the way how skin description is interpreted
+constexpr quint32 cache_version = 1;
+
+constexpr auto stream_version = QDataStream::Qt_6_4;
+
+// image paths are stored relative to skin root,
+// so cache entry doesn't depend on skin location
+ImageSizeMap toRelativePaths(const ImageSizeMap& sizes, const QDir& skin_root)
+{
+  ImageSizeMap res;
+  for (auto iter = sizes.begin(); iter != sizes.end(); ++iter)
+    res.insert(skin_root.relativeFilePath(iter.key()), iter.value());
+  return res;
+}
+
+ImageSizeMap toAbsolutePaths(const ImageSizeMap& sizes, const QDir& skin_root)
+{
+  ImageSizeMap res;
+  for (auto iter = sizes.begin(); iter != sizes.end(); ++iter)
+    res.insert(skin_root.absoluteFilePath(iter.key()), iter.value());
+  return res;
+}
+
+} // namespace
+
+SkinCache::SkinCache(const QString& cache_dir)
+  : _cache_dir(cache_dir)
+{
+}
+
+std::optional<CompiledSkin> SkinCache::load(const QByteArray& key, const QDir& skin_root) const
+{
+  if (key.isEmpty())
+    return std::nullopt;
+
+  QFile f(entryPath(key));
+  if (!f.open(QIODevice::ReadOnly))
+    return std::nullopt;
+
+  QDataStream in(&f);
+  in.setVersion(stream_version);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  in >> magic >> version;
+  if (magic != cache_magic || version != cache_version)
+    return std::nullopt;
+
+  QByteArray config;
+  ImageSizeMap image_sizes;
+  in >> config >> image_sizes;
+  if (in.status() != QDataStream::Ok)
+    return std::nullopt;
+
+  return CompiledSkin{
+    QCborValue::fromCbor(config).toJsonValue().toObject(),
+    toAbsolutePaths(image_sizes, skin_root),
+  };
+}
+
+bool SkinCache::store(const QByteArray& key, const QDir& skin_root, const CompiledSkin& skin) const
+{
+  if (key.isEmpty() || !_cache_dir.mkpath(u"."_s))
+    return false;
+
+  QSaveFile f(entryPath(key));
+  if (!f.open(QIODevice::WriteOnly))
+    return false;
+
+  QDataStream out(&f);
+  out.setVersion(stream_version);
+  out << cache_magic << cache_version;
+  out << QCborValue::fromJsonValue(skin.config).toCbor();
+  out << toRelativePaths(skin.image_sizes, skin_root);
+
+  return out.status() == QDataStream::Ok && f.commit();
+}
+
+QString SkinCache::entryPath(const QByteArray& key) const
+{
+  return _cache_dir.absoluteFilePath(QString::fromLatin1(key) + u".dcc"_s);
+}
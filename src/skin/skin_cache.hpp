@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <QByteArray>
+#include <QDir>
+#include <QJsonObject>
+
+#include "image_resource.hpp"
+
+// everything what can be reused on next skin load without parsing
+struct CompiledSkin {
+  QJsonObject config;         // parsed skin description (skin.json)
+  ImageSizeMap image_sizes;   // default sizes of all used images
+};
+
+// persistent storage for compiled skins, entries are keyed by skin state
+// (see SkinStateHash()), so any change in skin files invalidates entry
+class SkinCache final {
+public:
+  explicit SkinCache(const QString& cache_dir);
+
+  std::optional<CompiledSkin> load(const QByteArray& key, const QDir& skin_root) const;
+  bool store(const QByteArray& key, const QDir& skin_root, const CompiledSkin& skin) const;
+
+private:
+  QString entryPath(const QByteArray& key) const;
+
+private:
+  QDir _cache_dir;
+};
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "skin_finder.hpp"
+
+#include <optional>
+#include <utility>
+
+#include <QDir>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include "legacy_skin_loader.hpp"
+#include "modern_skin_loader.hpp"
+#include "skin_pack.hpp"
+
+namespace {
+
+std::optional<QString> tryLegacySkin(const QString& path)
+{
+  LegacySkinLoader loader(path);
+  if (loader.valid())
+    return loader.title();
+  return std::nullopt;
+}
+
+std::optional<QString> tryModernSkin(const QString& path)
+{
+  ModernSkinLoader loader(path);
+  if (loader.valid())
+    return loader.title();
+  return std::nullopt;
+}
+
+using ProbeResult = std::optional<std::pair<QString, SkinLocation>>;
+
+// called from worker threads, loaders only read skin metadata
+// (ini/json files), no resources are created at this stage
+ProbeResult probeSkin(const QString& path)
+{
+  // skin packs are probed as usual directories after mounting
+  const auto skin_path = IsSkinPack(path) ? MountSkinPack(path) : path;
+  if (skin_path.isEmpty())
+    return std::nullopt;
+
+  constexpr std::pair<SkinType, std::optional<QString>(*)(const QString&)> validators[] = {
+    {SkinType::Legacy, &tryLegacySkin},
+    {SkinType::Modern, &tryModernSkin},
+  };
+
+  for (const auto& [type, validator] : validators)
+    if (auto name = (*validator)(skin_path))
+      return std::make_pair(std::move(*name), SkinLocation{type, skin_path});
+
+  return std::nullopt;
+}
+
+} // namespace
+
+SkinLocations FindSkins(const QStringList& search_paths)
+{
+  QStringList candidates;
+  for (const auto& path : search_paths) {
+    QDir dir(path);
+    if (!dir.exists())
+      continue;
+    const auto items = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
+    for (const auto& item : items)
+      candidates.append(dir.absoluteFilePath(item));
+  }
+
+  // results are in the same order as candidates
+  const auto results = QtConcurrent::blockingMapped<QList<ProbeResult>>(candidates, &probeSkin);
+
+  SkinLocations skins;
+  for (const auto& r : results)
+    if (r)
+      skins[r->first] = r->second;
+
+  return skins;
+}
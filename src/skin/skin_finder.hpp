@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+enum class SkinType {
+  Legacy,
+  Modern,
+};
+
+struct SkinLocation {
+  SkinType type;
+  QString path;
+};
+
+using SkinLocations = QHash<QString, SkinLocation>;
+
+// looks for skins (directories or skin packs) in all given search paths,
+// all found items are probed concurrently, but results are merged in
+// search paths order, so skins from later paths override same-named
+// skins from earlier paths, skin packs are mounted during probing,
+// so path for them points to resource file system
+SkinLocations FindSkins(const QStringList& search_paths);
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "skin_pack.hpp"
+
+#include <memory>
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QResource>
+
+namespace {
+
+using namespace Qt::Literals::StringLiterals;
+
+constexpr auto skin_pack_suffix = "dcskin"_L1;
+
+class MountedPack final {
+public:
+  MountedPack(const QString& filename, const QString& map_root)
+    : _file(filename)
+    , _map_root(map_root)
+  {
+    if (!_file.open(QIODevice::ReadOnly))
+      return;
+    // the whole pack is mapped at once, all skin files
+    // are accessed directly from that memory
+    _data = _file.map(0, _file.size());
+    if (!_data)
+      return;
+    if (!QResource::registerResource(_data, _map_root)) {
+      _file.unmap(_data);
+      _data = nullptr;
+    }
+  }
+
+  ~MountedPack()
+  {
+    if (!_data)
+      return;
+    QResource::unregisterResource(_data, _map_root);
+    _file.unmap(_data);
+  }
+
+  bool isMounted() const noexcept { return _data != nullptr; }
+
+  QString skinRoot() const { return u":"_s + _map_root; }
+
+private:
+  QFile _file;
+  QString _map_root;
+  uchar* _data = nullptr;
+};
+
+struct MountedPacks {
+  QMutex lock;
+  QHash<QString, std::shared_ptr<MountedPack>> packs;
+};
+
+Q_GLOBAL_STATIC(MountedPacks, mounted_packs)
+
+// unique mount point for each pack file, the last path component
+// is pack file base name, it is used as fallback skin name
+QString mapRoot(const QFileInfo& fi)
+{
+  const auto path_hash = QCryptographicHash::hash(fi.absoluteFilePath().toUtf8(),
+                                                  QCryptographicHash::Sha1).toHex().left(16);
+  return u"/skin_packs/%1/%2"_s.arg(QString::fromLatin1(path_hash), fi.completeBaseName());
+}
+
+} // namespace
+
+bool IsSkinPack(const QString& filename)
+{
+  QFileInfo fi(filename);
+  return fi.isFile() && fi.suffix().compare(skin_pack_suffix, Qt::CaseInsensitive) == 0;
+}
+
+QString MountSkinPack(const QString& filename)
+{
+  QFileInfo fi(filename);
+  const auto key = fi.absoluteFilePath();
+
+  QMutexLocker _(&mounted_packs->lock);
+  auto& packs = mounted_packs->packs;
+  if (auto iter = packs.constFind(key); iter != packs.constEnd())
+    return iter.value()->skinRoot();
+
+  auto pack = std::make_shared<MountedPack>(key, mapRoot(fi));
+  if (!pack->isMounted())
+    return {};
+
+  packs.insert(key, pack);
+  return pack->skinRoot();
+}
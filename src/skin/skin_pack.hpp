@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QString>
+
+// skin pack is a single file with all skin files inside, it is just
+// Qt binary resource (see add_skin_pack() CMake function) which is
+// mapped into memory and mounted into resource file system,
+// so any skin loader can use it as usual skin directory
+
+bool IsSkinPack(const QString& filename);
+
+// mounts given skin pack and returns path to skin root, or empty string
+// on failure, packs stay mounted until application exit, mounting the
+// same file again returns the same path, can be called from any thread
+QString MountSkinPack(const QString& filename);
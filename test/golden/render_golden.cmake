@@ -0,0 +1,40 @@
+# SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# renders golden images for test_skin_render into this directory,
+# use clock_render built before any rendering changes:
+#   cmake -D CLOCK_RENDER=<path to clock_render> -P test/golden/render_golden.cmake
+# the same cases as test_skin_render has, file names are data tags
+
+if (NOT CLOCK_RENDER)
+    message(FATAL_ERROR "CLOCK_RENDER is not set")
+endif()
+
+get_filename_component(golden_dir ${CMAKE_CURRENT_LIST_DIR} ABSOLUTE)
+get_filename_component(skins_dir ${CMAKE_CURRENT_LIST_DIR}/../../res/skins ABSOLUTE)
+set(tmp_dir ${golden_dir}/.render)
+
+foreach(skin dseg electronic)
+    foreach(time 00:00:00 12:34:56 23:59:59)
+        foreach(scale 1.0 2.0)
+            foreach(dpr 1.0 2.0)
+                string(REPLACE ":" "" hhmmss ${time})
+                set(tag ${skin}_${hhmmss}_x${scale}_dpr${dpr})
+                execute_process(
+                    COMMAND ${CLOCK_RENDER}
+                        --time 2024-09-18T${time} --format hh:mm:ss --scale ${scale} --dpr ${dpr}
+                        --output ${tmp_dir} ${skins_dir}/${skin}
+                    RESULT_VARIABLE result
+                )
+                if (NOT result EQUAL 0)
+                    message(FATAL_ERROR "failed to render ${tag}")
+                endif()
+                file(RENAME ${tmp_dir}/frame_000000.png ${golden_dir}/${tag}.png)
+                message(STATUS "${tag}.png")
+            endforeach()
+        endforeach()
+    endforeach()
+endforeach()
+
+file(REMOVE_RECURSE ${tmp_dir})
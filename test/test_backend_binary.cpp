@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <QTest>
+
+#include <QColor>
+#include <QFile>
+#include <QJsonObject>
+#include <QPoint>
+#include <QTemporaryDir>
+
+#include "backend_binary.hpp"
+#include "backend_qsettings.hpp"
+
+using namespace Qt::Literals::StringLiterals;
+
+class BackendBinaryTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+  void cleanup();
+
+  void missingFile();
+  void saveAndLoad();
+  void batchedSaves();
+  void corruptedFile();
+  void corruptedFileBackup();
+  void migration();
+  void jsonExport();
+
+private:
+  QString settingsFile() const { return _dir->filePath(u"settings.dcb"_s); }
+
+private:
+  std::unique_ptr<QTemporaryDir> _dir;
+};
+
+void BackendBinaryTest::init()
+{
+  _dir = std::make_unique<QTemporaryDir>();
+  QVERIFY(_dir->isValid());
+}
+
+void BackendBinaryTest::cleanup()
+{
+  _dir.reset();
+}
+
+void BackendBinaryTest::missingFile()
+{
+  BackendBinary backend(settingsFile());
+  QVERIFY(!backend.isLoaded());
+  QVERIFY(backend.allSettings().empty());
+  QVERIFY(!backend.value(u"app"_s, u"foo"_s));
+}
+
+void BackendBinaryTest::saveAndLoad()
+{
+  {
+    BackendBinary backend(settingsFile());
+    backend.setValue(u"app"_s, u"ival"_s, 42);
+    backend.setValue(u"app"_s, u"color"_s, QColor(Qt::red));
+    backend.setValue(u"State/Window0"_s, u"Pos"_s, QPoint(10, 20));
+    backend.save(u"app"_s);
+    backend.flush();
+  }
+
+  BackendBinary backend(settingsFile());
+  QVERIFY(backend.isLoaded());
+  QCOMPARE(backend.value(u"app"_s, u"ival"_s)->toInt(), 42);
+  QCOMPARE(backend.value(u"app"_s, u"color"_s)->value<QColor>(), QColor(Qt::red));
+  QCOMPARE(backend.value(u"State/Window0"_s, u"Pos"_s)->toPoint(), QPoint(10, 20));
+  QCOMPARE(backend.tagSettings(u"app"_s).size(), 2);
+}
+
+void BackendBinaryTest::batchedSaves()
+{
+  BackendBinary backend(settingsFile());
+  backend.setValue(u"app"_s, u"ival"_s, 42);
+  backend.save(u"app"_s);
+  backend.setValue(u"State/Window0"_s, u"Pos"_s, QPoint(10, 20));
+  backend.save(u"State/Window0"_s);
+  // nothing is written until flush
+  QVERIFY(!QFile::exists(settingsFile()));
+
+  backend.flush();
+  QVERIFY(QFile::exists(settingsFile()));
+
+  // nothing was changed, so nothing must be written
+  QFile::remove(settingsFile());
+  backend.flush();
+  QVERIFY(!QFile::exists(settingsFile()));
+}
+
+void BackendBinaryTest::corruptedFile()
+{
+  const QByteArray garbage = "definitely not a settings file";
+  QFile file(settingsFile());
+  QVERIFY(file.open(QIODevice::WriteOnly));
+  file.write(garbage);
+  file.close();
+
+  {
+    BackendBinary backend(settingsFile());
+    QVERIFY(!backend.isLoaded());
+    QVERIFY(backend.isBroken());
+    QVERIFY(backend.allSettings().empty());
+
+    // broken file must never be overwritten
+    backend.migrateFrom(BackendQSettings(_dir->filePath(u"settings.ini"_s)));
+    QVERIFY(!backend.isLoaded());
+    backend.setValue(u"app"_s, u"ival"_s, 42);
+    backend.save(u"app"_s);
+    backend.flush();
+  }
+
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QCOMPARE(file.readAll(), garbage);
+}
+
+void BackendBinaryTest::corruptedFileBackup()
+{
+  const QByteArray garbage = "definitely not a settings file";
+  const auto backup_file = settingsFile() + u".bak"_s;
+  QFile file(settingsFile());
+  QVERIFY(file.open(QIODevice::WriteOnly));
+  file.write(garbage);
+  file.close();
+
+  const auto ini_file = _dir->filePath(u"settings.ini"_s);
+  {
+    BackendQSettings legacy(ini_file);
+    legacy.setValue(u"app"_s, u"ival"_s, 42);
+  }
+
+  BackendBinary backend(settingsFile());
+  QVERIFY(backend.isBroken());
+  QVERIFY(backend.backupBroken(backup_file));
+  QVERIFY(!backend.isBroken());
+  QVERIFY(!QFile::exists(settingsFile()));
+
+  // now settings can be migrated as if there was no file
+  backend.migrateFrom(BackendQSettings(ini_file));
+  QVERIFY(backend.isLoaded());
+  QCOMPARE(BackendBinary(settingsFile()).value(u"app"_s, u"ival"_s)->toInt(), 42);
+
+  QFile backup(backup_file);
+  QVERIFY(backup.open(QIODevice::ReadOnly));
+  QCOMPARE(backup.readAll(), garbage);
+}
+
+void BackendBinaryTest::migration()
+{
+  const auto ini_file = _dir->filePath(u"settings.ini"_s);
+  {
+    BackendQSettings legacy(ini_file);
+    legacy.setValue(u"app"_s, u"ival"_s, 42);
+    legacy.setValue(u"app/window"_s, u"sval"_s, u"42"_s);
+  }
+
+  BackendBinary backend(settingsFile());
+  backend.migrateFrom(BackendQSettings(ini_file));
+  QVERIFY(backend.isLoaded());
+
+  // migrated settings must be saved
+  BackendBinary reloaded(settingsFile());
+  QVERIFY(reloaded.isLoaded());
+  QCOMPARE(reloaded.value(u"app"_s, u"ival"_s)->toInt(), 42);
+  QCOMPARE(reloaded.value(u"app/window"_s, u"sval"_s)->toString(), u"42");
+}
+
+void BackendBinaryTest::jsonExport()
+{
+  BackendBinary backend(settingsFile());
+  backend.setValue(u"app"_s, u"ival"_s, 42);
+  backend.setValue(u"app"_s, u"brush"_s, QBrush(Qt::red));
+
+  const auto json = backend.toJson().object();
+  const auto app = json[u"app"_s].toObject();
+  QCOMPARE(app[u"ival"_s].toInt(), 42);
+  QCOMPARE(app[u"brush"_s].toString(), u"QBrush");
+}
+
+QTEST_MAIN(BackendBinaryTest)
+
+#include "test_backend_binary.moc"
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <functional>
+
+#include "classic_skin.hpp"
+
+namespace {
+
+// any character is an invisible box, enough to build layouts
+class BoxResourceFactory final : public ResourceFactory
+{
+public:
+  qreal ascent() const override { return 1.0; }
+  qreal descent() const override { return 0.0; }
+
+protected:
+  std::shared_ptr<Resource> create(char32_t) const override
+  {
+    return std::make_shared<InvisibleResource>(QRectF(0, -1, 1, 1), 1, 1);
+  }
+};
+
+class CountingObserver final : public SkinObserver
+{
+public:
+  void onConfigurationChanged() override { ++_notifications; }
+
+  int notifications() const noexcept { return _notifications; }
+
+private:
+  int _notifications = 0;
+};
+
+// any skin configuration change
+using SkinChange = std::function<void(ClassicSkin&)>;
+
+} // namespace
+
+Q_DECLARE_METATYPE(SkinChange)
+
+class ClassicSkinTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+  void cleanup();
+
+  void notifyOnEachChange();
+  void batchedUpdate();
+  void nestedUpdate();
+  void emptyUpdate();
+
+  void sameTextSameLayout();
+  void changedTextNewLayout();
+  void separatorNewLayout();
+  void configChangeDropsLayout_data();
+  void configChangeDropsLayout();
+
+private:
+  std::shared_ptr<ClassicSkin> _skin;
+  std::shared_ptr<CountingObserver> _observer;
+};
+
+void ClassicSkinTest::init()
+{
+  _skin = std::make_shared<ClassicSkin>(std::make_shared<BoxResourceFactory>());
+  _observer = std::make_shared<CountingObserver>();
+  _skin->addObserver(_observer);
+}
+
+void ClassicSkinTest::cleanup()
+{
+  _observer.reset();
+  _skin.reset();
+}
+
+void ClassicSkinTest::notifyOnEachChange()
+{
+  _skin->setSpacing(4);
+  _skin->setOrientation(Qt::Vertical);
+  _skin->setTexture(QColor(Qt::red));
+  QCOMPARE(_observer->notifications(), 3);
+}
+
+void ClassicSkinTest::batchedUpdate()
+{
+  {
+    SkinUpdateGuard _(*_skin);
+    _skin->setSpacing(4);
+    _skin->setOrientation(Qt::Vertical);
+    _skin->setTexture(QColor(Qt::red));
+    _skin->setFormat(QLatin1String("hh:mm:ss"));
+    QCOMPARE(_observer->notifications(), 0);
+  }
+  QCOMPARE(_observer->notifications(), 1);
+  QCOMPARE(_skin->spacing(), 4.0);
+  QVERIFY(_skin->orientation() == Qt::Vertical);
+  QCOMPARE(_skin->format(), u"hh:mm:ss");
+}
+
+void ClassicSkinTest::nestedUpdate()
+{
+  {
+    SkinUpdateGuard outer(*_skin);
+    {
+      SkinUpdateGuard inner(*_skin);
+      _skin->setSpacing(4);
+    }
+    QCOMPARE(_observer->notifications(), 0);
+    _skin->setBackground(QColor(Qt::blue));
+  }
+  QCOMPARE(_observer->notifications(), 1);
+}
+
+void ClassicSkinTest::emptyUpdate()
+{
+  {
+    SkinUpdateGuard _(*_skin);
+  }
+  QCOMPARE(_observer->notifications(), 0);
+}
+
+void ClassicSkinTest::sameTextSameLayout()
+{
+  _skin->setFormat(QLatin1String("hh:mm"));
+  const QDateTime dt(QDate(2024, 9, 18), QTime(12, 34, 10));
+  auto layout = _skin->process(dt);
+  QVERIFY(layout);
+  QCOMPARE(_skin->process(dt), layout);
+  // seconds are not displayed, so rendered text is the same
+  QCOMPARE(_skin->process(dt.addSecs(30)), layout);
+}
+
+void ClassicSkinTest::changedTextNewLayout()
+{
+  _skin->setFormat(QLatin1String("hh:mm:ss"));
+  const QDateTime dt(QDate(2024, 9, 18), QTime(12, 34, 56));
+  auto layout = _skin->process(dt);
+  QVERIFY(layout);
+  auto next = _skin->process(dt.addSecs(1));
+  QVERIFY(next);
+  QVERIFY(next != layout);
+}
+
+void ClassicSkinTest::separatorNewLayout()
+{
+  _skin->setFormat(QLatin1String("hh:mm"));
+  _skin->setSeparatorAnimationEnabled(true);
+  const QDateTime dt(QDate(2024, 9, 18), QTime(12, 34, 10));
+  auto layout = _skin->process(dt);
+  _skin->animateSeparator();
+  auto hidden = _skin->process(dt);
+  QVERIFY(hidden != layout);
+  // the same state again, but layout is memoized only for the last frame
+  QCOMPARE(_skin->process(dt), hidden);
+}
+
+void ClassicSkinTest::configChangeDropsLayout_data()
+{
+  QTest::addColumn<SkinChange>("change");
+
+  QTest::newRow("spacing") << SkinChange([](ClassicSkin& s) { s.setSpacing(4); });
+  QTest::newRow("orientation") << SkinChange([](ClassicSkin& s) { s.setOrientation(Qt::Vertical); });
+  QTest::newRow("texture") << SkinChange([](ClassicSkin& s) { s.setTexture(QColor(Qt::red)); });
+  QTest::newRow("locale") << SkinChange([](ClassicSkin& s) { s.setLocale(QLocale::c()); });
+  QTest::newRow("format") << SkinChange([](ClassicSkin& s) { s.setFormat(QLatin1String("hh:mm:ss")); });
+  QTest::newRow("batched") << SkinChange([](ClassicSkin& s) {
+    SkinUpdateGuard _(s);
+    s.setSpacing(4);
+    s.setIgnoreAdvanceX(true);
+  });
+}
+
+void ClassicSkinTest::configChangeDropsLayout()
+{
+  QFETCH(SkinChange, change);
+
+  _skin->setFormat(QLatin1String("hh:mm"));
+  const QDateTime dt(QDate(2024, 9, 18), QTime(12, 34, 10));
+  auto layout = _skin->process(dt);
+  QVERIFY(layout);
+
+  change(*_skin);
+  auto rebuilt = _skin->process(dt);
+  QVERIFY(rebuilt);
+  QVERIFY(rebuilt != layout);
+}
+
+QTEST_GUILESS_MAIN(ClassicSkinTest)
+
+#include "test_classic_skin.moc"
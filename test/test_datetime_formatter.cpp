@@ -40,6 +40,32 @@ private:
   QHash<QString, int> _tokens;
 };
 
+class BatchedDateTimeStringBuilder final : public DateTimeStringBuilder
+{
+public:
+  void addCharacters(std::span<const char32_t> chars) override
+  {
+    _result.append(QString::fromUcs4(chars.data(), chars.size()));
+  }
+
+  void addToken(int id, QStringView token, std::span<const char32_t> chars) override
+  {
+    _ids.append(id);
+    _result.append(u'[');
+    _result.append(token);
+    _result.append(u'=');
+    addCharacters(chars);
+    _result.append(u']');
+  }
+
+  const QString& result() const noexcept { return _result; }
+  const QList<int>& ids() const noexcept { return _ids; }
+
+private:
+  QString _result;
+  QList<int> _ids;
+};
+
 } // namespace
 
 class DateTimeFormatterTest : public QObject
@@ -59,6 +85,11 @@ private slots:
   void testComplexCase();
   void testUnicode();
   void testTokenNotify();
+  void testCompiledFormat();
+  void testLocaleSnapshot();
+  void testNativeDigits();
+  void testBatchedBuilder();
+  void testInvalidDateTime();
 
 private:
   SimpleDateTimeStringBuilder sb;
@@ -200,6 +231,73 @@ void DateTimeFormatterTest::testTokenNotify()
   QCOMPARE(sb.tokens()["ss"], 0);
 }
 
+void DateTimeFormatterTest::testCompiledFormat()
+{
+  const DateTimeFormat fmt(u"hh:mm:ss 'hh' hh");
+  const DateTimeLocale locale;
+  QCOMPARE(fmt.tokensCount(), 3);
+  QCOMPARE(fmt.tokenName(0), u"hh");
+  QCOMPARE(fmt.tokenName(1), u"mm");
+  QCOMPARE(fmt.tokenName(2), u"ss");
+  // the same format object should be reusable
+  FormatDateTime(dt, fmt, locale, sb);
+  QCOMPARE(sb.result(), u"12:30:56 hh 12");
+  QCOMPARE(sb.separators(), u"::");
+  sb.reset();
+  FormatDateTime(dt.addSecs(3600), fmt, locale, sb);
+  QCOMPARE(sb.result(), u"01:30:56 hh 01");
+  QCOMPARE(sb.tokens()["hh"], 0);
+  QVERIFY(DateTimeFormat().isEmpty());
+}
+
+void DateTimeFormatterTest::testLocaleSnapshot()
+{
+  const QLocale de(QLocale::German, QLocale::Germany);
+  const DateTimeLocale locale(de);
+  const QDateTime pm(dt.date(), QTime(15, 30, 56));
+  // names and AM/PM texts should match QLocale formatting
+  for (const auto& f : {u"ddd dddd", u"MMM MMMM", u"a A ap AP", u"d M dd MM yyyy"}) {
+    FormatDateTime(pm, DateTimeFormat(f), locale, sb);
+    QCOMPARE(sb.result(), de.toString(pm, f));
+    sb.reset();
+  }
+  // locale-specific case is preserved for mixed case tokens
+  FormatDateTime(dt, DateTimeFormat(u"Ap"), locale, sb);
+  QCOMPARE(sb.result(), de.amText());
+}
+
+void DateTimeFormatterTest::testNativeDigits()
+{
+  const DateTimeFormat fmt(u"H:mm:ss d.MM");
+  FormatDateTime(dt, fmt, DateTimeLocale(QLocale::c()), sb);
+  QCOMPARE(sb.result(), u"0:30:56 19.12");
+  sb.reset();
+  // digits should be taken from the locale
+  const QLocale ar(QLocale::Arabic, QLocale::Egypt);
+  FormatDateTime(dt, DateTimeFormat(u"HH"), DateTimeLocale(ar), sb);
+  QCOMPARE(sb.result(), ar.zeroDigit() + ar.zeroDigit());
+}
+
+void DateTimeFormatterTest::testBatchedBuilder()
+{
+  BatchedDateTimeStringBuilder bb;
+  FormatDateTime(dt, DateTimeFormat(u"hh'h'mm hh"), DateTimeLocale(QLocale::c()), bb);
+  QCOMPARE(bb.result(), u"[hh=12]h[mm=30] [hh=12]");
+  QCOMPARE(bb.ids(), QList<int>({0, 1, 0}));
+}
+
+void DateTimeFormatterTest::testInvalidDateTime()
+{
+  // invalid time gives -1 for all fields, they must be formatted as numbers
+  const QDateTime invalid;
+  FormatDateTime(invalid, DateTimeFormat(u"H:mm:s"), DateTimeLocale(QLocale::c()), sb);
+  QCOMPARE(sb.result(), u"-1:-1:-1");
+  sb.reset();
+  // the same as QString::arg() does, sign is a part of padded field
+  FormatDateTime(invalid, DateTimeFormat(u"HH"), DateTimeLocale(QLocale::c()), sb);
+  QCOMPARE(sb.result(), u"-1");
+}
+
 QTEST_MAIN(DateTimeFormatterTest)
 
 #include "test_datetime_formatter.moc"
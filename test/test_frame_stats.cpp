@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include "app/frame_stats.hpp"
+
+using namespace std::chrono_literals;
+
+class FrameStatsTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void emptySummary();
+  void summary();
+  void summaryWrapAround();
+  void stagesAreIndependent();
+  void histogram();
+  void layoutHitRate();
+  void reset();
+};
+
+void FrameStatsTest::emptySummary()
+{
+  FrameStats stats;
+  const auto s = stats.summary(FrameStats::Paint);
+  QVERIFY(s.last == FrameStats::Duration::zero());
+  QVERIFY(s.average == FrameStats::Duration::zero());
+  QVERIFY(s.max == FrameStats::Duration::zero());
+  QCOMPARE(stats.frames(), std::uint64_t(0));
+}
+
+void FrameStatsTest::summary()
+{
+  FrameStats stats;
+  stats.add(FrameStats::Draw, 2ms);
+  stats.add(FrameStats::Draw, 6ms);
+  stats.add(FrameStats::Draw, 1ms);
+
+  const auto s = stats.summary(FrameStats::Draw);
+  QVERIFY(s.last == 1ms);
+  QVERIFY(s.average == 3ms);
+  QVERIFY(s.max == 6ms);
+}
+
+void FrameStatsTest::summaryWrapAround()
+{
+  FrameStats stats;
+  // these values must be pushed out of the history
+  for (int i = 0; i < 10; i++)
+    stats.add(FrameStats::Paint, 1s);
+  for (std::size_t i = 1; i <= FrameStats::history_size; i++)
+    stats.add(FrameStats::Paint, std::chrono::milliseconds(i));
+
+  const auto s = stats.summary(FrameStats::Paint);
+  QVERIFY(s.last == std::chrono::milliseconds(FrameStats::history_size));
+  QVERIFY(s.max == std::chrono::milliseconds(FrameStats::history_size));
+  // average of 1..N ms
+  QVERIFY(s.average == std::chrono::microseconds((FrameStats::history_size + 1) * 500));
+
+  // all frames are counted, not only kept ones
+  QCOMPARE(stats.frames(), std::uint64_t(FrameStats::history_size + 10));
+}
+
+void FrameStatsTest::stagesAreIndependent()
+{
+  FrameStats stats;
+  stats.add(FrameStats::Process, 1ms);
+  stats.add(FrameStats::Draw, 2ms);
+
+  QVERIFY(stats.summary(FrameStats::Process).max == 1ms);
+  QVERIFY(stats.summary(FrameStats::Draw).max == 2ms);
+  QVERIFY(stats.summary(FrameStats::Paint).max == FrameStats::Duration::zero());
+  // only paint stage is a frame
+  QCOMPARE(stats.frames(), std::uint64_t(0));
+  for (auto n : stats.paintHistogram())
+    QCOMPARE(n, std::uint64_t(0));
+}
+
+void FrameStatsTest::histogram()
+{
+  FrameStats stats;
+  stats.add(FrameStats::Paint, 0us);      // [0]
+  stats.add(FrameStats::Paint, 250us);    // [0], bounds are inclusive
+  stats.add(FrameStats::Paint, 251us);    // [1]
+  stats.add(FrameStats::Paint, 1500us);   // [3]
+  stats.add(FrameStats::Paint, 33ms);     // [7]
+  stats.add(FrameStats::Paint, 34ms);     // the extra bucket
+  stats.add(FrameStats::Paint, 1s);       // the extra bucket
+
+  const FrameStats::Histogram expected = {2, 1, 0, 1, 0, 0, 0, 1, 2};
+  QVERIFY(stats.paintHistogram() == expected);
+  QCOMPARE(stats.frames(), std::uint64_t(7));
+}
+
+void FrameStatsTest::layoutHitRate()
+{
+  FrameStats stats;
+  QCOMPARE(stats.layoutHitRate(), 0.0);
+
+  stats.addLayoutLookup(false);
+  QCOMPARE(stats.layoutHitRate(), 0.0);
+  stats.addLayoutLookup(true);
+  stats.addLayoutLookup(true);
+  stats.addLayoutLookup(true);
+  QCOMPARE(stats.layoutHitRate(), 0.75);
+}
+
+void FrameStatsTest::reset()
+{
+  FrameStats stats;
+  stats.add(FrameStats::Paint, 5ms);
+  stats.addLayoutLookup(true);
+  stats.reset();
+
+  QCOMPARE(stats.frames(), std::uint64_t(0));
+  QCOMPARE(stats.layoutHitRate(), 0.0);
+  QVERIFY(stats.summary(FrameStats::Paint).max == FrameStats::Duration::zero());
+  QCOMPARE(stats.paintHistogram()[4], std::uint64_t(0));
+}
+
+QTEST_GUILESS_MAIN(FrameStatsTest)
+
+#include "test_frame_stats.moc"
@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QPixmapCache>
+#include <QTemporaryDir>
+
+#include "image_resource.hpp"
+#include "resource_factory.hpp"
+
+namespace {
+
+QString svgFile(char ch)
+{
+  return QString("%1/%2.svg").arg(ELECTRONIC_SKIN_DIR).arg(ch);
+}
+
+qint64 svgFileSize(char ch)
+{
+  return QFileInfo(svgFile(ch)).size();
+}
+
+void drawResource(Resource& r)
+{
+  QImage canvas(64, 64, QImage::Format_ARGB32_Premultiplied);
+  canvas.fill(Qt::transparent);
+  QPainter p(&canvas);
+  r.draw(&p);
+}
+
+// digits are SVG images, everything else is not supported
+class SvgResourceFactory final : public ResourceFactory
+{
+public:
+  qreal ascent() const override { return 1.0; }
+  qreal descent() const override { return 0.0; }
+
+protected:
+  std::shared_ptr<Resource> create(char32_t ch) const override
+  {
+    if (ch >= U'0' && ch <= U'9')
+      return std::make_shared<SvgImageResource>(svgFile(char(ch)));
+    return nullptr;
+  }
+};
+
+} // namespace
+
+class ResourceMemoryTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+
+  void rasterImage();
+  void rasterImageDeferred();
+  void svgImage();
+  void svgImageDeferred();
+  void factory();
+  void cachedPixmaps();
+  void cachedPixmapsLimit();
+
+private:
+  QString createPng(const QSize& sz);
+
+private:
+  QTemporaryDir _dir;
+};
+
+void ResourceMemoryTest::init()
+{
+  QVERIFY(_dir.isValid());
+  ClearCachedPixmaps();
+}
+
+QString ResourceMemoryTest::createPng(const QSize& sz)
+{
+  QImage img(sz, QImage::Format_ARGB32);
+  img.fill(Qt::red);
+  const auto filename = _dir.filePath(QString("%1x%2.png").arg(sz.width()).arg(sz.height()));
+  return img.save(filename) ? filename : QString();
+}
+
+void ResourceMemoryTest::rasterImage()
+{
+  const auto filename = createPng({10, 20});
+  QVERIFY(!filename.isEmpty());
+
+  RasterImageResource r(filename);
+  QCOMPARE(r.memoryUsage().images, std::size_t(10 * 20 * 4));
+  QCOMPARE(r.memoryUsage().total(), r.memoryUsage().images);
+}
+
+void ResourceMemoryTest::rasterImageDeferred()
+{
+  const auto filename = createPng({10, 20});
+  QVERIFY(!filename.isEmpty());
+
+  // nothing is loaded until first draw
+  RasterImageResource r(filename, {10, 20});
+  QCOMPARE(r.memoryUsage().total(), std::size_t(0));
+
+  drawResource(r);
+  QCOMPARE(r.memoryUsage().images, std::size_t(10 * 20 * 4));
+}
+
+void ResourceMemoryTest::svgImage()
+{
+  SvgImageResource r(svgFile('0'));
+  QVERIFY(svgFileSize('0') > 0);
+  QCOMPARE(r.memoryUsage().vector, std::size_t(svgFileSize('0')));
+  QCOMPARE(r.memoryUsage().total(), r.memoryUsage().vector);
+}
+
+void ResourceMemoryTest::svgImageDeferred()
+{
+  // nothing is parsed until first draw
+  SvgImageResource r(svgFile('0'), {10, 20});
+  QCOMPARE(r.memoryUsage().total(), std::size_t(0));
+
+  drawResource(r);
+  QCOMPARE(r.memoryUsage().vector, std::size_t(svgFileSize('0')));
+}
+
+void ResourceMemoryTest::factory()
+{
+  SvgResourceFactory f;
+  QCOMPARE(f.memoryUsage().total(), std::size_t(0));
+
+  // only created resources are counted, each only once
+  f.item(U'0');
+  f.item(U'1');
+  f.item(U'1');
+  QCOMPARE(f.memoryUsage().vector, std::size_t(svgFileSize('0') + svgFileSize('1')));
+
+  // unsupported characters (both Latin-1 and not) don't affect usage
+  QVERIFY(!f.item(U'a'));
+  QVERIFY(!f.item(U'\u0436'));
+  QCOMPARE(f.memoryUsage().vector, std::size_t(svgFileSize('0') + svgFileSize('1')));
+}
+
+void ResourceMemoryTest::cachedPixmaps()
+{
+  QCOMPARE(CachedPixmapsMemoryUsage().total(), std::size_t(0));
+
+  auto r = std::make_shared<SvgImageResource>(svgFile('0'));
+  r->setGeometry(QRectF(0, 0, 10, 20), 10, 20);
+  CachedResource cached(r);
+  drawResource(cached);
+
+  // 32 bpp pixmap of resource's size
+  QCOMPARE(CachedPixmapsMemoryUsage().cache, std::size_t(10 * 20 * 4));
+  // cache is not a part of resource's usage
+  QCOMPARE(cached.memoryUsage().cache, std::size_t(0));
+
+  // the same pixmap is counted only once
+  drawResource(cached);
+  QCOMPARE(CachedPixmapsMemoryUsage().cache, std::size_t(10 * 20 * 4));
+
+  ClearCachedPixmaps();
+  QCOMPARE(CachedPixmapsMemoryUsage().total(), std::size_t(0));
+}
+
+void ResourceMemoryTest::cachedPixmapsLimit()
+{
+  const int cache_limit = QPixmapCache::cacheLimit();
+  QPixmapCache::setCacheLimit(1);   // KiB, only one 800 bytes pixmap fits
+
+  auto r = std::make_shared<SvgImageResource>(svgFile('0'));
+  r->setGeometry(QRectF(0, 0, 10, 20), 10, 20);
+  CachedResource cached(r);
+  drawResource(cached);
+  QCOMPARE(CachedPixmapsMemoryUsage().cache, std::size_t(10 * 20 * 4));
+
+  // the least recently used pixmap is evicted, as the cache does
+  r->setGeometry(QRectF(0, 0, 20, 10), 20, 10);
+  drawResource(cached);
+  QCOMPARE(CachedPixmapsMemoryUsage().cache, std::size_t(20 * 10 * 4));
+
+  QPixmapCache::setCacheLimit(cache_limit);
+}
+
+QTEST_MAIN(ResourceMemoryTest)
+
+#include "test_resource_memory.moc"
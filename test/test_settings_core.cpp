@@ -10,8 +10,11 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "core/config_base.hpp"
 #include "core/settings.hpp"
+#include "core/write_behind_backend.hpp"
 
 using ConfigStorageType = ConfigStorage<std::string, std::string, std::any>;
 using ConfigClientType = ConfigClient<std::string, std::any>;
@@ -49,10 +52,17 @@ public:
   {}
 
   void load(const std::string&) override {}
-  void save(const std::string&) override {}
+  void save(const std::string&) override { ++_save_calls; }
+  void flush() override { ++_flush_calls; }
 
   SettingsData allSettings() const override { return _all_settings; }
 
+  SettingsMap tagSettings(const std::string& tag) const override
+  {
+    ++_tag_settings_calls;
+    return ConfigBackend::tagSettings(tag);
+  }
+
   void setValue(const std::string& tag, const std::string& k, const std::any& v) override
   {
     _all_settings[tag][k] = v;
@@ -71,8 +81,23 @@ public:
     return viter->second;
   }
 
+  int tagSettingsCalls() const noexcept { return _tag_settings_calls; }
+  int saveCalls() const noexcept { return _save_calls; }
+  int flushCalls() const noexcept { return _flush_calls; }
+
 private:
   SettingsData _all_settings;
+  mutable int _tag_settings_calls = 0;
+  int _save_calls = 0;
+  int _flush_calls = 0;
+};
+
+class TestConfig final : public ConfigBase<std::string, std::any> {
+  CONFIG_OPTION(int, IVal, "ival"s, 0)
+  CONFIG_OPTION(std::string, SVal, "sval"s, ""s)
+  CONFIG_OPTION(int, Var1, "var1"s, 0)
+public:
+  using ConfigBase::ConfigBase;
 };
 
 } // namespace
@@ -94,6 +119,11 @@ private slots:
   void multipleClients();
   void testExport();
   void testImport();
+  void testSnapshot();
+  void testWriteBehind();
+  void testGeneratedOptions();
+  void testCachedOptions();
+  void testRevisions();
 
 private:
   std::unique_ptr<ConfigStorageType> _storage;
@@ -270,6 +300,148 @@ void SettingsCoreTest::testImport()
   QCOMPARE(_config->value<int>(key, 0), imported_value);
 }
 
+void SettingsCoreTest::testSnapshot()
+{
+  auto backend = std::make_shared<TestConfigBackend>();
+  ConfigStorageType storage(backend);
+  auto config = storage.client("app");
+
+  // backend should be queried only once per tag
+  QCOMPARE(config->value<int>("ival", 0), 42);
+  QCOMPARE(config->value<std::string>("sval", ""s), "42"s);
+  QCOMPARE(config->value<int>("var1", 0), 0);
+  QCOMPARE(backend->tagSettingsCalls(), 1);
+
+  // commit must invalidate the snapshot
+  config->setValue("var1", 1);
+  config->commit();
+  QCOMPARE(config->value<int>("var1", 0), 1);
+  QCOMPARE(config->value<int>("ival", 0), 42);
+  QCOMPARE(backend->tagSettingsCalls(), 2);
+
+  // as well as import
+  ConfigStorageType::SettingsData imported;
+  imported["app"s]["var1"s] = 37;
+  storage.importSettings(imported);
+  storage.commitImported();
+  QCOMPARE(config->value<int>("var1", 0), 37);
+  QCOMPARE(backend->tagSettingsCalls(), 3);
+}
+
+void SettingsCoreTest::testWriteBehind()
+{
+  using WriteBehindBackendType = WriteBehindBackend<std::string, std::string, std::any>;
+  auto backend = std::make_shared<TestConfigBackend>();
+  int scheduled = 0;
+  auto write_behind = std::make_shared<WriteBehindBackendType>(backend, [&]() { ++scheduled; });
+  ConfigStorageType storage(write_behind);
+  auto config = storage.client("app");
+
+  config->setValue("var1", 1);
+  config->commit();
+  config->setValue("var1", 2);
+  config->commit();
+  QCOMPARE(scheduled, 2);
+
+  // nothing is written until flush, but values are visible
+  QVERIFY(!backend->value("app"s, "var1"s));
+  QCOMPARE(backend->saveCalls(), 0);
+  QCOMPARE(backend->flushCalls(), 0);
+  QCOMPARE(config->value<int>("var1", 0), 2);
+  QVERIFY(write_behind->hasPendingWrites());
+
+  // all changes are written at once
+  write_behind->flush();
+  QVERIFY(!write_behind->hasPendingWrites());
+  QCOMPARE(std::any_cast<int>(*backend->value("app"s, "var1"s)), 2);
+  QCOMPARE(backend->saveCalls(), 1);
+  QCOMPARE(backend->flushCalls(), 1);
+  QCOMPARE(config->value<int>("var1", 0), 2);
+
+  // backend is flushed only if something was written
+  write_behind->flush();
+  QCOMPARE(backend->flushCalls(), 1);
+}
+
+void SettingsCoreTest::testGeneratedOptions()
+{
+  TestConfig config(_storage->client("app"));
+  QCOMPARE(config.getIVal(), 42);
+  QCOMPARE(config.getSVal(), "42"s);
+  config.setVar1(5);
+  QCOMPARE(config.getVar1(), 5);
+  QCOMPARE(_config->value<int>("var1", 0), 5);
+  QCOMPARE(TestConfig::Var1Key(), "var1"s);
+}
+
+void SettingsCoreTest::testCachedOptions()
+{
+  TestConfig config(_storage->client("app"));
+  QCOMPARE(config.getIVal(), 42);
+  // cached value must be updated on change from any other client
+  _config->setValue("ival", 7);
+  QCOMPARE(config.getIVal(), 7);
+
+  std::vector<std::string> changed;
+  auto id = config.subscribe([&changed](const std::string& k) { changed.push_back(k); });
+  config.setVar1(1);
+  config.setVar1(2);
+  config.setIVal(3);
+  QVERIFY(changed == std::vector{"var1"s, "var1"s, "ival"s});
+  QCOMPARE(config.getVar1(), 2);
+  QCOMPARE(config.getIVal(), 3);
+
+  // each reverted option is reported only once
+  changed.clear();
+  config.discard();
+  QVERIFY(changed == std::vector{"var1"s, "ival"s});
+  QCOMPARE(config.getVar1(), 0);
+  QCOMPARE(config.getIVal(), 42);
+
+  // nothing is reported after commit
+  config.setVar1(5);
+  config.commit();
+  changed.clear();
+  config.discard();
+  QVERIFY(changed.empty());
+  QCOMPARE(config.getVar1(), 5);
+
+  config.unsubscribe(id);
+  config.setVar1(6);
+  QVERIFY(changed.empty());
+}
+
+void SettingsCoreTest::testRevisions()
+{
+  auto other = _storage->client("other");
+  auto revision = _config->revision();
+
+  // changes of other tags don't affect cached values
+  other->setValue("var1", 1);
+  other->commit();
+  other->setValue("var1", 2);
+  other->discard();
+  QCOMPARE(_config->revision(), revision);
+
+  // commit doesn't change visible values
+  _config->setValue("var1", 1);
+  QVERIFY(_config->revision() != revision);
+  revision = _config->revision();
+  _config->commit();
+  QCOMPARE(_config->revision(), revision);
+
+  // all clients of the same tag see the change
+  auto same = _storage->client("app");
+  revision = same->revision();
+  _config->discard();
+  QVERIFY(same->revision() != revision);
+
+  // import affects everything
+  revision = _config->revision();
+  _storage->importSettings({});
+  QVERIFY(_config->revision() != revision);
+}
+
 QTEST_MAIN(SettingsCoreTest)
 
 #include "test_settings_core.moc"
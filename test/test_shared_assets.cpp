@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QTemporaryDir>
+
+#include "legacy_skin_loader.hpp"
+#include "shared_assets.hpp"
+#include "shared_registry.hpp"
+
+class SharedAssetsTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void registrySharesObjects();
+  void registryRecreatesExpired();
+
+  void assetsKeyDependsOnLocation();
+  void legacySkinSharesGlyphs();
+};
+
+void SharedAssetsTest::registrySharesObjects()
+{
+  SharedRegistry<QString, int> registry;
+  int created = 0;
+  auto create = [&]() { ++created; return std::make_shared<int>(42); };
+
+  auto a = registry.get("a", create);
+  auto b = registry.get("a", create);
+  QCOMPARE(created, 1);
+  QCOMPARE(a, b);
+
+  auto c = registry.get("c", create);
+  QCOMPARE(created, 2);
+  QVERIFY(a != c);
+}
+
+void SharedAssetsTest::registryRecreatesExpired()
+{
+  SharedRegistry<QString, int> registry;
+  int created = 0;
+  auto create = [&]() { return std::make_shared<int>(++created); };
+
+  auto a = registry.get("a", create);
+  QCOMPARE(*a, 1);
+  a.reset();
+
+  // registry doesn't keep objects alive
+  a = registry.get("a", create);
+  QCOMPARE(created, 2);
+  QCOMPARE(*a, 2);
+}
+
+void SharedAssetsTest::assetsKeyDependsOnLocation()
+{
+  QTemporaryDir dir1;
+  QTemporaryDir dir2;
+  QVERIFY(dir1.isValid());
+  QVERIFY(dir2.isValid());
+
+  // empty skins have the same state, but in different locations
+  QCOMPARE(SkinStateHash(QDir(dir1.path())), SkinStateHash(QDir(dir2.path())));
+  QVERIFY(SkinAssetsKey(QDir(dir1.path())) != SkinAssetsKey(QDir(dir2.path())));
+  QVERIFY(SkinAssetsKey(QDir(dir1.path())).endsWith(QString::fromLatin1(SkinStateHash(QDir(dir1.path())))));
+}
+
+void SharedAssetsTest::legacySkinSharesGlyphs()
+{
+  const QDir skin_dir(ELECTRONIC_SKIN_DIR);
+  // factory created from empty files map has no glyphs,
+  // so it is possible to distinguish it from the shared one
+  auto shared_factory = [&]() { return SharedImageResourceFactory(SkinAssetsKey(skin_dir), {}); };
+
+  LegacySkinLoader loader(skin_dir.absolutePath());
+  QVERIFY(loader.valid());
+  auto skin1 = loader.skin();
+  auto skin2 = loader.skin();
+  QVERIFY(skin1);
+  QVERIFY(skin2);
+
+  // both skins use the factory registered by the first load
+  auto factory = shared_factory();
+  QVERIFY(factory->item(U'0'));
+  QCOMPARE(shared_factory(), factory);
+
+  // the last user is gone, so factory must be created again
+  skin1.reset();
+  skin2.reset();
+  factory.reset();
+  QVERIFY(!shared_factory()->item(U'0'));
+}
+
+QTEST_MAIN(SharedAssetsTest)
+
+#include "test_shared_assets.moc"
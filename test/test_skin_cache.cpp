@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "shared_assets.hpp"
+#include "skin_cache.hpp"
+
+namespace {
+
+bool writeFile(const QString& filename, const QByteArray& data)
+{
+  QFile f(filename);
+  return f.open(QIODevice::WriteOnly) && f.write(data) == data.size();
+}
+
+// cache key depends on modification time, so it is preserved
+bool copyFile(const QString& src, const QString& dst)
+{
+  if (!QFile::copy(src, dst))
+    return false;
+  QFile f(dst);
+  return f.open(QIODevice::ReadWrite) &&
+         f.setFileTime(QFileInfo(src).lastModified(), QFileDevice::FileModificationTime);
+}
+
+} // namespace
+
+class SkinCacheTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void init();
+  void cleanup();
+
+  void missingEntry();
+  void storeAndLoad();
+  void relocatedSkin();
+  void contentChange();
+
+private:
+  std::unique_ptr<QTemporaryDir> _skin_dir;
+  std::unique_ptr<QTemporaryDir> _cache_dir;
+};
+
+void SkinCacheTest::init()
+{
+  _skin_dir = std::make_unique<QTemporaryDir>();
+  _cache_dir = std::make_unique<QTemporaryDir>();
+  QVERIFY(_skin_dir->isValid());
+  QVERIFY(_cache_dir->isValid());
+
+  QVERIFY(writeFile(_skin_dir->filePath("skin.json"), R"({"name": "test"})"));
+  QVERIFY(writeFile(_skin_dir->filePath("1.svg"), "<svg/>"));
+}
+
+void SkinCacheTest::cleanup()
+{
+  _skin_dir.reset();
+  _cache_dir.reset();
+}
+
+void SkinCacheTest::missingEntry()
+{
+  SkinCache cache(_cache_dir->path());
+  QDir skin_root(_skin_dir->path());
+  const auto key = SkinStateHash(skin_root);
+  QVERIFY(!key.isEmpty());
+  QVERIFY(!cache.load(key, skin_root));
+}
+
+void SkinCacheTest::storeAndLoad()
+{
+  SkinCache cache(_cache_dir->path());
+  QDir skin_root(_skin_dir->path());
+  const auto key = SkinStateHash(skin_root);
+
+  CompiledSkin skin;
+  skin.config["name"] = "test";
+  skin.config["spacing"] = 2.5;
+  skin.image_sizes[skin_root.absoluteFilePath("1.svg")] = QSizeF(10, 20);
+  QVERIFY(cache.store(key, skin_root, skin));
+
+  const auto loaded = cache.load(key, skin_root);
+  QVERIFY(loaded);
+  QCOMPARE(loaded->config, skin.config);
+  QCOMPARE(loaded->image_sizes, skin.image_sizes);
+}
+
+void SkinCacheTest::relocatedSkin()
+{
+  SkinCache cache(_cache_dir->path());
+  QDir skin_root(_skin_dir->path());
+  const auto key = SkinStateHash(skin_root);
+
+  CompiledSkin skin;
+  skin.image_sizes[skin_root.absoluteFilePath("1.svg")] = QSizeF(10, 20);
+  QVERIFY(cache.store(key, skin_root, skin));
+
+  // the same files in other location must produce the same key
+  QTemporaryDir other_dir;
+  QVERIFY(other_dir.isValid());
+  QVERIFY(copyFile(_skin_dir->filePath("skin.json"), other_dir.filePath("skin.json")));
+  QVERIFY(copyFile(_skin_dir->filePath("1.svg"), other_dir.filePath("1.svg")));
+  QDir other_root(other_dir.path());
+  QCOMPARE(SkinStateHash(other_root), key);
+
+  const auto loaded = cache.load(key, other_root);
+  QVERIFY(loaded);
+  QCOMPARE(loaded->image_sizes.value(other_root.absoluteFilePath("1.svg")), QSizeF(10, 20));
+}
+
+void SkinCacheTest::contentChange()
+{
+  QDir skin_root(_skin_dir->path());
+  const auto key = SkinStateHash(skin_root);
+  QVERIFY(writeFile(_skin_dir->filePath("1.svg"), "<svg></svg>"));
+  QVERIFY(SkinStateHash(skin_root) != key);
+}
+
+QTEST_GUILESS_MAIN(SkinCacheTest)
+
+#include "test_skin_cache.moc"
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "legacy_skin_loader.hpp"
+#include "modern_skin_loader.hpp"
+#include "render_utils.hpp"
+#include "skin_finder.hpp"
+#include "skin_pack.hpp"
+
+namespace {
+
+// renders skin into image, returns true if anything has been drawn
+bool renderSkin(Skin& skin)
+{
+  const auto img = RenderFrame(skin, QDateTime(QDate(2024, 9, 18), QTime(12, 34, 56)));
+  if (img.isNull())
+    return false;
+
+  for (int y = 0; y < img.height(); y++) {
+    const auto line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+    for (int x = 0; x < img.width(); x++)
+      if (qAlpha(line[x]) != 0)
+        return true;
+  }
+  return false;
+}
+
+} // namespace
+
+class SkinPackTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void notAPack();
+  void mountLegacySkin();
+  void mountModernSkin();
+  void mountTwice();
+  void renderLegacySkin();
+  void renderModernSkin();
+  void findPacks();
+};
+
+void SkinPackTest::notAPack()
+{
+  QVERIFY(!IsSkinPack(QFINDTESTDATA("test_skin_pack.cpp")));
+  QVERIFY(IsSkinPack(ELECTRONIC_SKIN_PACK));
+
+  QTemporaryDir tmp_dir;
+  QVERIFY(tmp_dir.isValid());
+  const auto fake_pack = tmp_dir.filePath("fake.dcskin");
+  QFile f(fake_pack);
+  QVERIFY(f.open(QIODevice::WriteOnly));
+  QVERIFY(f.write("definitely not a resource file") > 0);
+  f.close();
+  QVERIFY(MountSkinPack(fake_pack).isEmpty());
+}
+
+void SkinPackTest::mountLegacySkin()
+{
+  const auto skin_root = MountSkinPack(ELECTRONIC_SKIN_PACK);
+  QVERIFY(skin_root.startsWith(':'));
+
+  LegacySkinLoader loader(skin_root);
+  QVERIFY(loader.valid());
+  QCOMPARE(loader.title(), u"Electronic (built-in)");
+}
+
+void SkinPackTest::mountModernSkin()
+{
+  const auto skin_root = MountSkinPack(DSEG_SKIN_PACK);
+  QVERIFY(skin_root.startsWith(':'));
+
+  ModernSkinLoader loader(skin_root);
+  QVERIFY(loader.valid());
+  QCOMPARE(loader.title(), u"DSEG font (built-in)");
+}
+
+void SkinPackTest::mountTwice()
+{
+  QCOMPARE(MountSkinPack(DSEG_SKIN_PACK), MountSkinPack(DSEG_SKIN_PACK));
+}
+
+// SVG images from uncompressed packs are parsed right from mapped memory
+void SkinPackTest::renderLegacySkin()
+{
+  LegacySkinLoader loader(MountSkinPack(ELECTRONIC_SKIN_PACK));
+  QVERIFY(loader.valid());
+  auto skin = loader.skin();
+  QVERIFY(skin);
+  skin->setFormat("hh:mm:ss");
+  QVERIFY(renderSkin(*skin));
+}
+
+// custom fonts are loaded from the pack
+void SkinPackTest::renderModernSkin()
+{
+  ModernSkinLoader loader(MountSkinPack(DSEG_SKIN_PACK));
+  QVERIFY(loader.valid());
+  auto skin = loader.skin();
+  QVERIFY(skin);
+  QVERIFY(renderSkin(*skin));
+}
+
+void SkinPackTest::findPacks()
+{
+  QTemporaryDir tmp_dir;
+  QVERIFY(tmp_dir.isValid());
+  QVERIFY(QFile::copy(ELECTRONIC_SKIN_PACK, tmp_dir.filePath("electronic.dcskin")));
+  QVERIFY(QFile::copy(DSEG_SKIN_PACK, tmp_dir.filePath("dseg.dcskin")));
+
+  const auto skins = FindSkins({tmp_dir.path()});
+  QCOMPARE(skins.size(), 2);
+  QVERIFY(skins.value("Electronic (built-in)").type == SkinType::Legacy);
+  QVERIFY(skins.value("DSEG font (built-in)").type == SkinType::Modern);
+}
+
+QTEST_MAIN(SkinPackTest)
+
+#include "test_skin_pack.moc"
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <QTest>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include "render_utils.hpp"
+
+// golden images are rendered by clock_render before any rendering changes
+// (see golden/render_golden.cmake) and are a part of the sources, any
+// mismatch or missing golden image is an error
+//
+// frame time is only reported by default, it depends on machine load,
+// comparison against baseline (with given JSON file) is opt-in:
+//   DIGITAL_CLOCK_NEXT_RECORD_BASELINE=1 DIGITAL_CLOCK_NEXT_FRAME_TIME_BASELINE=<file> ctest -R test_skin_render
+//   DIGITAL_CLOCK_NEXT_FRAME_TIME_BASELINE=<file> ctest -R test_skin_render
+namespace {
+
+static constexpr const char* const FrameTimeBaselineVar = "DIGITAL_CLOCK_NEXT_FRAME_TIME_BASELINE";
+static constexpr const char* const RecordBaselineVar = "DIGITAL_CLOCK_NEXT_RECORD_BASELINE";
+
+constexpr int color_tolerance = 8;          // max per-channel difference
+constexpr qreal max_diff_ratio = 0.001;     // max ratio of different pixels
+constexpr qreal time_budget_factor = 1.5;   // allowed slowdown vs baseline
+constexpr int perf_frames_count = 300;
+
+bool recordMode()
+{
+  return qEnvironmentVariableIntValue(RecordBaselineVar) != 0;
+}
+
+QDir goldenDir()
+{
+  return QDir(GOLDEN_DIR);
+}
+
+// returns ratio of pixels differing more than allowed, diff image
+// (differing pixels are red) is written to given image if provided
+qreal compareImages(const QImage& actual, const QImage& expected, QImage* diff = nullptr)
+{
+  Q_ASSERT(actual.size() == expected.size());
+  const auto a = actual.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+  const auto e = expected.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+  if (diff) {
+    *diff = QImage(a.size(), QImage::Format_ARGB32_Premultiplied);
+    diff->fill(Qt::transparent);
+  }
+
+  auto channel_diff = [](QRgb c1, QRgb c2) {
+    return std::max({std::abs(qRed(c1) - qRed(c2)), std::abs(qGreen(c1) - qGreen(c2)),
+                     std::abs(qBlue(c1) - qBlue(c2)), std::abs(qAlpha(c1) - qAlpha(c2))});
+  };
+
+  qint64 different = 0;
+  for (int y = 0; y < a.height(); y++) {
+    const auto la = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+    const auto le = reinterpret_cast<const QRgb*>(e.constScanLine(y));
+    for (int x = 0; x < a.width(); x++) {
+      if (channel_diff(la[x], le[x]) <= color_tolerance)
+        continue;
+      different++;
+      if (diff) diff->setPixel(x, y, qRgba(255, 0, 0, 255));
+    }
+  }
+  return qreal(different) / (qint64(a.width()) * a.height());
+}
+
+QString baselineFile()
+{
+  return qEnvironmentVariable(FrameTimeBaselineVar);
+}
+
+QJsonObject loadBaseline()
+{
+  QFile f(baselineFile());
+  if (!f.open(QIODevice::ReadOnly))
+    return {};
+  return QJsonDocument::fromJson(f.readAll()).object();
+}
+
+bool saveBaseline(const QJsonObject& baseline)
+{
+  QSaveFile f(baselineFile());
+  if (!f.open(QIODevice::WriteOnly))
+    return false;
+  f.write(QJsonDocument(baseline).toJson());
+  return f.commit();
+}
+
+} // namespace
+
+class SkinRenderTest : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void goldenImage_data();
+  void goldenImage();
+
+  void frameTime_data();
+  void frameTime();
+};
+
+void SkinRenderTest::goldenImage_data()
+{
+  QTest::addColumn<QString>("skin");
+  QTest::addColumn<QTime>("time");
+  QTest::addColumn<qreal>("scale");
+  QTest::addColumn<qreal>("dpr");
+
+  const QTime times[] = {QTime(0, 0, 0), QTime(12, 34, 56), QTime(23, 59, 59)};
+
+  for (const char* skin : {"dseg", "electronic"})
+    for (const auto& t : times)
+      for (qreal scale : {1.0, 2.0})
+        for (qreal dpr : {1.0, 2.0})
+          QTest::addRow("%s_%s_x%.1f_dpr%.1f", skin, qPrintable(t.toString("hhmmss")), scale, dpr)
+              << QString(skin) << t << scale << dpr;
+}
+
+void SkinRenderTest::goldenImage()
+{
+  QFETCH(QString, skin);
+  QFETCH(QTime, time);
+  QFETCH(qreal, scale);
+  QFETCH(qreal, dpr);
+
+  auto s = LoadSkin(QDir(SKINS_DIR).filePath(skin), "hh:mm:ss");
+  QVERIFY(s);
+
+  const auto actual = RenderFrame(*s, QDateTime(QDate(2024, 9, 18), time), scale, dpr);
+  QVERIFY(!actual.isNull());
+
+  const auto golden_file = goldenDir().filePath(QString("%1.png").arg(QTest::currentDataTag()));
+  QImage expected(golden_file);
+  QVERIFY2(!expected.isNull(), qPrintable(QString("no golden image %1").arg(golden_file)));
+
+  QCOMPARE(actual.size(), expected.size());
+
+  QImage diff;
+  const auto diff_ratio = compareImages(actual, expected, &diff);
+  if (diff_ratio > max_diff_ratio) {
+    // keep results for inspection
+    QDir out(QDir::current().filePath("skin_render_failures"));
+    out.mkpath(".");
+    actual.save(out.filePath(QString("%1_actual.png").arg(QTest::currentDataTag())));
+    diff.save(out.filePath(QString("%1_diff.png").arg(QTest::currentDataTag())));
+  }
+  QVERIFY2(diff_ratio <= max_diff_ratio,
+           qPrintable(QString("%1% pixels differ").arg(diff_ratio * 100, 0, 'f', 3)));
+}
+
+void SkinRenderTest::frameTime_data()
+{
+  QTest::addColumn<QString>("skin");
+  QTest::addColumn<qreal>("scale");
+
+  for (const char* skin : {"dseg", "electronic"})
+    for (qreal scale : {1.0, 2.0})
+      QTest::addRow("%s_x%.1f", skin, scale) << QString(skin) << scale;
+}
+
+void SkinRenderTest::frameTime()
+{
+  QFETCH(QString, skin);
+  QFETCH(qreal, scale);
+
+  auto s = LoadSkin(QDir(SKINS_DIR).filePath(skin), "hh:mm:ss");
+  QVERIFY(s);
+
+  // warm up caches, the same as any running clock has them warm
+  QDateTime dt(QDate(2024, 9, 18), QTime(23, 55, 0));
+  QVERIFY(!RenderFrame(*s, dt, scale, 1.0).isNull());
+
+  std::vector<qint64> times;
+  times.reserve(perf_frames_count);
+  QElapsedTimer timer;
+  for (int i = 0; i < perf_frames_count; i++) {
+    dt = dt.addSecs(1);
+    timer.start();
+    const auto frame = RenderFrame(*s, dt, scale, 1.0);
+    times.push_back(timer.nsecsElapsed());
+    QVERIFY(!frame.isNull());
+  }
+
+  std::ranges::sort(times);
+  const qint64 median = times[times.size() / 2];
+  qInfo("median frame time: %.1f us", median / 1000.);
+
+  if (baselineFile().isEmpty())
+    return;
+
+  const QString key = QTest::currentDataTag();
+  auto baseline = loadBaseline();
+
+  if (recordMode()) {
+    baseline[key] = median;
+    QVERIFY(saveBaseline(baseline));
+    return;
+  }
+
+  QVERIFY2(baseline.contains(key), qPrintable(QString("no frame time baseline for %1").arg(key)));
+
+  const auto budget = static_cast<qint64>(baseline[key].toInteger() * time_budget_factor);
+  QVERIFY2(median <= budget,
+           qPrintable(QString("median frame time %1 us exceeds budget %2 us")
+                      .arg(median / 1000.).arg(budget / 1000.)));
+}
+
+QTEST_MAIN(SkinRenderTest)
+
+#include "test_skin_render.moc"
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// headless clock renderer, renders given skin at given time (or time range)
+// into PNG files or into raw frames stream, useful for scripted regression
+// or performance testing and for skin previews generation
+
+#include <cstdio>
+
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QImage>
+#include <QTextStream>
+
+#include "render_utils.hpp"
+
+int main(int argc, char* argv[])
+{
+  // no display is required, but allow to override platform if needed
+  if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication app(argc, argv);
+  QGuiApplication::setApplicationName("clock_render");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Renders clock skin into PNG files or raw frames stream.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("skin", "Skin directory or skin pack file.");
+
+  QCommandLineOption format_opt({"f", "format"}, "Time format (legacy skins only).", "format");
+  QCommandLineOption time_opt({"t", "time"}, "Time to render (ISO 8601), current time by default.", "time");
+  QCommandLineOption frames_opt({"n", "frames"}, "Number of frames to render.", "count", "1");
+  QCommandLineOption step_opt("step", "Time step between frames in seconds.", "seconds", "1");
+  QCommandLineOption scale_opt({"s", "scale"}, "Scale factor.", "scale", "1.0");
+  QCommandLineOption dpr_opt("dpr", "Device pixel ratio.", "dpr", "1.0");
+  QCommandLineOption animate_opt("animate-separator", "Animate separator every frame.");
+  QCommandLineOption output_opt({"o", "output"}, "Output directory for PNG files.", "dir", ".");
+  QCommandLineOption raw_opt("raw", "Write raw RGBA8888 frames to stdout instead of PNG files, "
+                             "all frames have the size of the first frame.");
+  parser.addOptions({format_opt, time_opt, frames_opt, step_opt, scale_opt, dpr_opt,
+                     animate_opt, output_opt, raw_opt});
+  parser.process(app);
+
+  // stdout may be used for frames data, so all messages go to stderr
+  QTextStream err(stderr);
+
+  if (parser.positionalArguments().size() != 1)
+    parser.showHelp(1);
+
+  auto skin = LoadSkin(parser.positionalArguments().first(), parser.value(format_opt));
+  if (!skin) {
+    err << "failed to load skin: " << parser.positionalArguments().first() << Qt::endl;
+    return 1;
+  }
+
+  QDateTime dt = parser.isSet(time_opt)
+                 ? QDateTime::fromString(parser.value(time_opt), Qt::ISODate)
+                 : QDateTime::currentDateTime();
+  if (!dt.isValid()) {
+    err << "invalid time: " << parser.value(time_opt) << Qt::endl;
+    return 1;
+  }
+
+  bool ok = true;
+  const int frames = parser.value(frames_opt).toInt(&ok);
+  const int step = ok ? parser.value(step_opt).toInt(&ok) : 0;
+  const qreal scale = ok ? parser.value(scale_opt).toDouble(&ok) : 0;
+  const qreal dpr = ok ? parser.value(dpr_opt).toDouble(&ok) : 0;
+  if (!ok || frames <= 0 || scale <= 0 || dpr <= 0) {
+    err << "invalid frames count, step, scale or device pixel ratio" << Qt::endl;
+    return 1;
+  }
+
+  const bool raw = parser.isSet(raw_opt);
+  const QDir output_dir(parser.value(output_opt));
+  if (!raw && !output_dir.exists() && !output_dir.mkpath(".")) {
+    err << "failed to create output directory: " << output_dir.path() << Qt::endl;
+    return 1;
+  }
+
+  QFile out;
+  if (raw && !out.open(stdout, QIODevice::WriteOnly)) {
+    err << "failed to open stdout" << Qt::endl;
+    return 1;
+  }
+
+  FrameTimes process_times;
+  FrameTimes draw_times;
+  FrameTimes save_times;
+
+  QImage canvas;
+  QElapsedTimer timer;
+
+  for (int i = 0; i < frames; i++) {
+    timer.start();
+    if (parser.isSet(animate_opt))
+      skin->animateSeparator();
+    auto glyph = skin->process(dt);
+    const auto process_time = timer.nsecsElapsed();
+    if (!glyph) {
+      err << "failed to render frame " << i << Qt::endl;
+      return 1;
+    }
+
+    // raw frames must be of the same size, so canvas is created only once
+    const auto sz = FrameSize(*glyph, scale, dpr);
+    if (canvas.isNull() || (!raw && canvas.size() != sz)) {
+      canvas = QImage(sz, QImage::Format_RGBA8888_Premultiplied);
+      canvas.setDevicePixelRatio(dpr);
+      if (raw)
+        err << "frame size: " << sz.width() << "x" << sz.height() << Qt::endl;
+    }
+    DrawFrame(canvas, *glyph, scale);
+    const auto draw_time = timer.nsecsElapsed();
+
+    if (raw) {
+      const auto frame = canvas.convertToFormat(QImage::Format_RGBA8888);
+      out.write(reinterpret_cast<const char*>(frame.constBits()), frame.sizeInBytes());
+    } else {
+      const auto filename = output_dir.filePath(QString("frame_%1.png").arg(i, 6, 10, QChar('0')));
+      if (!canvas.save(filename)) {
+        err << "failed to save " << filename << Qt::endl;
+        return 1;
+      }
+    }
+    const auto save_time = timer.nsecsElapsed();
+
+    process_times.add(process_time);
+    draw_times.add(draw_time - process_time);
+    save_times.add(save_time - draw_time);
+
+    dt = dt.addSecs(step);
+  }
+
+  err << "frames: " << frames << Qt::endl;
+  err << process_times.report("process") << Qt::endl;
+  err << draw_times.report("draw") << Qt::endl;
+  err << save_times.report(raw ? "write" : "save") << Qt::endl;
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "render_utils.hpp"
+
+#include <algorithm>
+
+#include <QPainter>
+
+#include "legacy_skin_loader.hpp"
+#include "modern_skin_loader.hpp"
+#include "skin_pack.hpp"
+
+std::unique_ptr<Skin> LoadSkin(const QString& path, const QString& format)
+{
+  const auto skin_path = IsSkinPack(path) ? MountSkinPack(path) : path;
+  if (skin_path.isEmpty())
+    return nullptr;
+
+  if (LegacySkinLoader loader(skin_path); loader.valid()) {
+    auto skin = loader.skin();
+    if (skin) skin->setFormat(format);
+    return skin;
+  }
+
+  // modern skins have time format defined by skin itself
+  if (ModernSkinLoader loader(skin_path); loader.valid())
+    return loader.skin();
+
+  return nullptr;
+}
+
+QSize FrameSize(const Resource& frame, qreal scale, qreal dpr)
+{
+  return (frame.rect().size() * scale * dpr).toSize();
+}
+
+void DrawFrame(QImage& canvas, Resource& frame, qreal scale)
+{
+  canvas.fill(Qt::transparent);
+  QPainter p(&canvas);
+  p.setRenderHint(QPainter::Antialiasing);
+  p.setRenderHint(QPainter::SmoothPixmapTransform);
+  p.scale(scale, scale);
+  p.translate(-frame.rect().topLeft());
+  frame.draw(&p);
+}
+
+QImage RenderFrame(Skin& skin, const QDateTime& dt, qreal scale, qreal dpr)
+{
+  auto frame = skin.process(dt);
+  if (!frame) return {};
+
+  QImage canvas(FrameSize(*frame, scale, dpr), QImage::Format_ARGB32_Premultiplied);
+  canvas.setDevicePixelRatio(dpr);
+  DrawFrame(canvas, *frame, scale);
+  return canvas;
+}
+
+qint64 FrameTimes::percentile(qreal q)
+{
+  if (_times.empty()) return 0;
+  std::ranges::sort(_times);
+  auto i = std::min(_times.size() - 1, static_cast<std::size_t>(q * _times.size()));
+  return _times[i];
+}
+
+QString FrameTimes::report(const char* name)
+{
+  auto us = [this](qreal q) { return percentile(q) / 1000.; };
+  return QString("%1: p50 %2 us, p90 %3 us, p99 %4 us, max %5 us")
+      .arg(name, 8)
+      .arg(us(0.5), 0, 'f', 1)
+      .arg(us(0.9), 0, 'f', 1)
+      .arg(us(0.99), 0, 'f', 1)
+      .arg(us(1.0), 0, 'f', 1);
+}
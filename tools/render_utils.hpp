@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Nick Korotysh <nick.korotysh@gmail.com>
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QDateTime>
+#include <QImage>
+#include <QString>
+
+#include "skin.hpp"
+
+// helpers shared by headless renderer, benchmarks and tests,
+// all of them render skin the same way as clock widget does
+
+// loads skin from directory or skin pack,
+// format is applied only to legacy skins
+std::unique_ptr<Skin> LoadSkin(const QString& path, const QString& format);
+
+// canvas size required to draw given resource with given scale
+QSize FrameSize(const Resource& frame, qreal scale, qreal dpr);
+// canvas is cleared before drawing,
+// its device pixel ratio must be already set
+void DrawFrame(QImage& canvas, Resource& frame, qreal scale);
+// processes skin and draws result into new image, null image on error
+QImage RenderFrame(Skin& skin, const QDateTime& dt, qreal scale = 1.0, qreal dpr = 1.0);
+
+// values in nanoseconds
+class FrameTimes final
+{
+public:
+  void add(qint64 t) { _times.push_back(t); }
+
+  // q in [0,1]
+  qint64 percentile(qreal q);
+
+  QString report(const char* name);
+
+private:
+  std::vector<qint64> _times;
+};